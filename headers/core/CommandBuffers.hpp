@@ -7,7 +7,18 @@
 
 #include <vulkan/vulkan_core.h>
 #include <vector>
-#include "Vertex.hpp"
+#include "ResourcePools.hpp"
+#include "GpuProfiler.hpp"
+#include "Metrics.hpp"
+#include "FrameArena.hpp"
+#include "InstanceBuffer.hpp"
+#include "RenderQueue.hpp"
+#include "GpuScene.hpp"
+#include "BindlessDescriptors.hpp"
+#include "UniformRing.hpp"
+#include "DynamicResolution.hpp"
+#include "QueueFamilyIndices.hpp"
+#include "FrameReadback.hpp"
 
 namespace dvk {
 
@@ -17,33 +28,62 @@ namespace dvk {
         std::vector<VkCommandBuffer> commandBuffers;
         VkPhysicalDevice* physicalDevice;
         VkDevice* device;
-        VkSurfaceKHR* surface;
+        const QueueFamilyIndices* queueFamilyIndices;
         std::vector<VkFramebuffer>* swapchainFramebuffers;
+        std::vector<VkImage>* targetImages;
         VkRenderPass* renderPass;
         VkExtent2D* swapChainExtent;
-        VkPipeline* graphicsPipeline;
-        VkBuffer* vertexBuffer;
-        std::vector<Vertex>* vertices;
+        ResourcePools* resourcePools;
+        RenderQueue* renderQueue;
+        // Bound to binding 1 for the whole frame when set
+        InstanceBuffer* instanceBuffer;
+        // Culled and drawn on the GPU after the render queue when set
+        GpuScene* gpuScene;
+        // The scene is culled by a compute queue submission instead of at the start of the frame
+        bool asyncCulling = false;
+        // Bound once per frame when set, every graphics pipeline shares its layout
+        BindlessDescriptors* bindlessDescriptors;
+        // Per-draw uniforms, bound at each packet's offset
+        UniformRing* uniformRing;
+        // When set the scene is drawn into its scaled target and upscaled into the output image
+        DynamicResolution* dynamicResolution;
+        GpuProfiler* gpuProfiler;
+        // Copies the target image at the end of the frames it was asked to when set
+        FrameReadback* frameReadback;
+        memory::FrameArenas* frameArenas;
+        metrics::RendererMetrics* rendererMetrics;
 
         void createCommandBuffers();
         void createCommandPool();
+        uint32_t recordDraws(VkCommandBuffer commandBuffer, uint32_t frame);
     public:
         CommandBuffers(
                 VkPhysicalDevice* physicalDevice,
                 VkDevice* device,
-                VkSurfaceKHR* surface,
+                const QueueFamilyIndices* queueFamilyIndices,
                 std::vector<VkFramebuffer>* swapchainFramebuffers,
+                std::vector<VkImage>* targetImages,
                 VkRenderPass* renderPass,
                 VkExtent2D* swapChainExtent,
-                VkPipeline* graphicsPipeline,
-                VkBuffer* vertexBuffer,
-                std::vector<Vertex>* vertices
+                ResourcePools* resourcePools,
+                RenderQueue* renderQueue,
+                InstanceBuffer* instanceBuffer,
+                GpuScene* gpuScene,
+                BindlessDescriptors* bindlessDescriptors,
+                UniformRing* uniformRing,
+                DynamicResolution* dynamicResolution,
+                GpuProfiler* gpuProfiler,
+                FrameReadback* frameReadback,
+                memory::FrameArenas* frameArenas
                 );
 
         ~CommandBuffers();
         std::vector<VkCommandBuffer>* getCommandBuffer();
 
+        // Points recording at the framebuffers of a recreated swapchain, the command buffers themselves are kept
+        void setRenderTargets(std::vector<VkFramebuffer>* swapchainFramebuffers, std::vector<VkImage>* targetImages, VkExtent2D* swapChainExtent);
         void recordCommandBuffer(int currentFrame, uint32_t imageIndex);
+        void setAsyncCulling(bool asyncCulling);
     };
 
 } // dvk
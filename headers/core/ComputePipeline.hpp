@@ -0,0 +1,63 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_COMPUTEPIPELINE_HPP
+#define DRAFT_VK_COMPUTEPIPELINE_HPP
+
+#include <vulkan/vulkan_core.h>
+#include <string>
+#include <vector>
+#include "ResourcePools.hpp"
+
+namespace dvk {
+
+    // A compute shader from resources/shaders with its layout: one descriptor set of `bindings`, allocated from a pool
+    // of `maxDescriptorSets` sets owned by the pipeline, and an optional push constant range starting at offset 0.
+    class ComputePipeline {
+    private:
+        VkPipelineLayout pipelineLayout{};
+        VkPipeline computePipeline{};
+        VkShaderModule shaderModule{};
+        VkDescriptorSetLayout descriptorSetLayout{};
+        VkDescriptorPool descriptorPool{};
+        VkDevice* device;
+        std::vector<VkDescriptorSetLayoutBinding> bindings;
+        uint32_t pushConstantSize;
+        uint32_t maxDescriptorSets;
+        ResourcePools* resourcePools;
+        PipelineHandle pipelineHandle;
+
+        VkShaderModule createShaderModule(const std::vector<char>& code);
+        void createDescriptorSetLayout();
+        void createDescriptorPool();
+        void createComputePipeline(const std::string& shaderFile);
+    public:
+        ComputePipeline(
+                VkDevice* device,
+                const std::string& shaderFile,
+                std::vector<VkDescriptorSetLayoutBinding> bindings,
+                uint32_t pushConstantSize,
+                uint32_t maxDescriptorSets,
+                ResourcePools* resourcePools
+                );
+        ~ComputePipeline();
+
+        VkDescriptorSet allocateDescriptorSet();
+        // The descriptor type is the one of the binding in the layout
+        void writeBuffer(VkDescriptorSet descriptorSet, uint32_t binding, VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+
+        void bind(VkCommandBuffer commandBuffer, VkDescriptorSet descriptorSet);
+        void pushConstants(VkCommandBuffer commandBuffer, const void* data, uint32_t size);
+        // Group counts, not invocations
+        void dispatch(VkCommandBuffer commandBuffer, uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1);
+
+        VkPipeline* getComputePipeline();
+        VkPipelineLayout* getPipelineLayout();
+        VkDescriptorSetLayout* getDescriptorSetLayout();
+        PipelineHandle getPipelineHandle() const;
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_COMPUTEPIPELINE_HPP
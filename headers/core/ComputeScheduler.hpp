@@ -0,0 +1,52 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_COMPUTESCHEDULER_HPP
+#define DRAFT_VK_COMPUTESCHEDULER_HPP
+
+#include <vulkan/vulkan_core.h>
+#include <vector>
+#include "Metrics.hpp"
+
+namespace dvk {
+
+    // Records and submits compute work on the compute queue, one command buffer per frame in flight, so that it
+    // overlaps the graphics work of the previous frame. The frame's graphics submission waits on getFinishedSemaphore
+    // at getWaitStage; a frame whose graphics submission waited on it is known to have finished its compute work once
+    // its in flight fence signals, which is what makes re-recording the frame's command buffer safe.
+    class ComputeScheduler {
+    private:
+        VkDevice* device;
+        VkQueue* computeQueue;
+        uint32_t computeFamily;
+        const uint32_t framesInFlight;
+        VkCommandPool commandPool{};
+        std::vector<VkCommandBuffer> commandBuffers;
+        std::vector<VkSemaphore> finishedSemaphores;
+        // Set between submit and the graphics submission waiting on it
+        std::vector<bool> pending;
+        metrics::RendererMetrics* rendererMetrics;
+
+        void createCommandPool();
+        void createCommandBuffers();
+        void createSemaphores();
+    public:
+        ComputeScheduler(VkDevice* device, VkQueue* computeQueue, uint32_t computeFamily, uint32_t framesInFlight);
+        ~ComputeScheduler();
+
+        // Starts recording the frame's compute work, the frame's fence must have been waited on
+        VkCommandBuffer begin(uint32_t frame);
+        // Submits the frame's compute work, it signals the frame's semaphore when done
+        void submit(uint32_t frame);
+        // Consumes the signal of the frame's submit, the caller's graphics submission must wait on it
+        VkSemaphore* getFinishedSemaphore(uint32_t frame);
+        [[nodiscard]]
+        bool isPending(uint32_t frame) const;
+        [[nodiscard]]
+        static VkPipelineStageFlags getWaitStage();
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_COMPUTESCHEDULER_HPP
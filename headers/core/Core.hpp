@@ -5,6 +5,9 @@
 #ifndef DRAFT_VK_CORE_HPP
 #define DRAFT_VK_CORE_HPP
 
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include "Window.hpp"
 #include "Instance.hpp"
 #include "Surface.hpp"
@@ -17,34 +20,131 @@
 #include "CommandBuffers.hpp"
 #include "Synchronization.hpp"
 #include "VertexBuffer.hpp"
+#include "InstanceBuffer.hpp"
+#include "RenderQueue.hpp"
+#include "TripleBuffer.hpp"
+#include "SceneSnapshot.hpp"
+#include "JobSystem.hpp"
+#include "GpuScene.hpp"
+#include "ComputeScheduler.hpp"
+#include "OffscreenTargets.hpp"
+#include "Options.hpp"
+#include "Benchmark.hpp"
+#include "FramePacer.hpp"
+#include "DynamicResolution.hpp"
+#include "GpuProfiler.hpp"
+#include "Metrics.hpp"
+#include "MetricsExporter.hpp"
+#include "FrameArena.hpp"
+#include "ResourcePools.hpp"
+#include "StartupGraph.hpp"
+#include "FrameReadback.hpp"
+#include "FrameCapture.hpp"
 
 namespace dvk::Core {
 
     class Core {
     private:
         int currentFrame = 0;
+        uint64_t frameNumber = 0;
         const int MAX_FRAMES_IN_FLIGHT = 2;
+        // Longest the event loop waits for events before it publishes a new snapshot
+        static constexpr double SIMULATION_STEP = 1.0 / 240.0;
+        // Simulated time between headless frames, so that their output does not depend on how fast they run
+        static constexpr double HEADLESS_FRAME_TIME = 1.0 / 60.0;
+        Options options;
+        const std::chrono::steady_clock::time_point processStart;
+        VkSurfaceKHR headlessSurface = VK_NULL_HANDLE;
+        // Declared first so that it outlives every object registered in it
+        std::unique_ptr<ResourcePools> resourcePools;
+        // Constructed on the main thread, which is its worker 0
+        std::unique_ptr<jobs::JobSystem> jobSystem;
+        // Builds everything below up to the synchronization objects, kept for its stage timings
+        std::unique_ptr<StartupGraph> startupGraph;
+        // Format the render pass was created with, before the swapchain existed
+        VkFormat renderFormat = VK_FORMAT_UNDEFINED;
+        // Pipelines only need a valid extent to be created with, their viewport and scissor are dynamic
+        VkExtent2D pipelineExtent;
         std::unique_ptr<Window> window;
         std::unique_ptr<Instance> instance;
         std::unique_ptr<Surface> surface;
         std::unique_ptr<Debug> debug;
         std::unique_ptr<Device> device;
+        // Null when the device lacks descriptor indexing, pipelines then have empty layouts
+        std::unique_ptr<BindlessDescriptors> bindlessDescriptors;
+        std::unique_ptr<UniformRing> uniformRing;
         std::unique_ptr<Swapchain> swapchain;
+        std::unique_ptr<OffscreenTargets> offscreenTargets;
         std::unique_ptr<SwapchainImageViews> swapchainImageViews;
         std::unique_ptr<RenderPass> renderPass;
         std::unique_ptr<GraphicsPipeline> graphicsPipeline;
         std::unique_ptr<Framebuffers> framebuffers;
+        // Null without a resolution budget, the scene is then drawn straight into the target images
+        std::unique_ptr<DynamicResolution> dynamicResolution;
         std::unique_ptr<VertexBuffer> vertexBuffer;
+        std::unique_ptr<InstanceBuffer> instanceBuffer;
+        std::unique_ptr<GpuScene> gpuScene;
+        std::unique_ptr<ComputeScheduler> computeScheduler;
+        std::unique_ptr<GpuProfiler> gpuProfiler;
+        // Both null without a capture directory. The capture is destroyed first, it holds the readback's buffers
+        // until the images queued are written.
+        std::unique_ptr<FrameReadback> frameReadback;
+        std::unique_ptr<FrameCapture> frameCapture;
+        // One arena per job worker, recording runs on worker 0
+        std::unique_ptr<memory::FrameArenas> frameArenas;
+        std::unique_ptr<RenderQueue> renderQueue;
         std::unique_ptr<CommandBuffers> commandBuffers;
         std::unique_ptr<Synchronization> synchronization;
+        std::unique_ptr<Benchmark> benchmark;
+        // Null without a target frame rate
+        std::unique_ptr<FramePacer> framePacer;
+        ReportFormat reportFormat;
+        // CPU time of the frame last recorded in each slot, minus the time spent blocked, to classify it once its GPU time is back
+        std::vector<double> cpuBusyTimes;
+        metrics::RendererMetrics* rendererMetrics;
+        // Null without a metrics output, runs while frames are drawn
+        std::unique_ptr<metrics::MetricsExporter> metricsExporter;
+        // Published by the event loop, the render thread takes the newest one at the start of each frame
+        TripleBuffer<SceneSnapshot> snapshots;
+        uint64_t publishedSnapshots = 0;
+        // Simulation time of the last frame requested in on-demand mode
+        double lastRedrawTime = 0.0;
+        // Frames asked of the render thread in on-demand mode, it sleeps until the count changes
+        std::atomic<uint64_t> redrawRequests{0};
+        std::atomic<bool> sceneDirty{false};
+        std::atomic<bool> renderThreadStopping{false};
+        std::atomic<bool> renderThreadFinished{false};
+        std::exception_ptr renderThreadError;
 
+        VkSurfaceKHR* getSurface();
+        std::vector<VkImage>* getTargetImages();
+        VkFormat* getTargetImageFormat();
+        VkExtent2D* getTargetExtent();
+        bool acquireNextImage(uint32_t& imageIndex);
+        void presentImage(uint32_t imageIndex);
         void recreateSwapchain();
+        void simulate(double time);
+        void requestFrame();
+        double handleEvents(double time);
+        void renderLoop();
+        std::unique_ptr<GpuScene> createGpuScene();
+        std::unique_ptr<DynamicResolution> createDynamicResolution();
+        void writeInstances();
+        void buildRenderQueue();
+        void writeDrawUniforms(DrawPacket& packet);
+        void writeBenchmarkReport();
+        void runStartupBenchmark();
+        void exportMetrics();
+        void checkFrameAllocations();
         void init();
     public:
-        Core();
+        // processStart is taken first thing in main, the startup benchmark's time to first frame is measured from it
+        Core(const Options& options, std::chrono::steady_clock::time_point processStart);
 
         void drawFrame();
         void start();
+        // Safe to call from any thread, in on-demand mode the next frame is drawn after it
+        void markSceneDirty();
     };
 
 } // dvk
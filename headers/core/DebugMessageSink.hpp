@@ -0,0 +1,114 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_DEBUGMESSAGESINK_HPP
+#define DRAFT_VK_DEBUGMESSAGESINK_HPP
+
+#include <vulkan/vulkan_core.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include "MpscQueue.hpp"
+
+namespace dvk {
+
+    constexpr uint32_t DEBUG_MESSAGE_ID_SIZE = 128;
+    constexpr uint32_t DEBUG_MESSAGE_TEXT_SIZE = 2048;
+    constexpr uint64_t DEBUG_MESSAGE_QUEUE_SIZE = 256;
+    // Messages printed per message ID and second by default, 0 prints all of them
+    constexpr uint32_t DEFAULT_DEBUG_RATE_LIMIT = 10;
+
+    struct DebugMessage {
+        VkDebugUtilsMessageSeverityFlagBitsEXT severity{};
+        VkDebugUtilsMessageTypeFlagsEXT type = 0;
+        int32_t idNumber = 0;
+        std::chrono::steady_clock::time_point time{};
+        // Truncated copies, the driver's strings only live for the duration of the callback
+        char idName[DEBUG_MESSAGE_ID_SIZE]{};
+        char text[DEBUG_MESSAGE_TEXT_SIZE]{};
+    };
+
+    // Takes the debug messenger's messages off the driver threads: the callback copies each one into a lock-free
+    // queue, a background thread drains it and writes to stderr. Messages of an ID identical to one already printed
+    // are only counted, the others are printed up to a rate per ID, and everything is tallied for a summary of the
+    // performance warnings.
+    class DebugMessageSink {
+    private:
+        struct MessageStats {
+            VkDebugUtilsMessageSeverityFlagBitsEXT severity{};
+            VkDebugUtilsMessageTypeFlagsEXT type = 0;
+            std::string name;
+            std::string firstText;
+            uint64_t count = 0;
+            uint64_t printed = 0;
+            // Same text as a printed message of the ID
+            uint64_t duplicates = 0;
+            // Over the rate limit, reported with the next message of the ID that is printed
+            uint64_t suppressed = 0;
+            uint64_t pendingSuppressed = 0;
+            std::chrono::steady_clock::time_point windowStart{};
+            uint32_t printedInWindow = 0;
+            std::unordered_set<size_t> printedTexts;
+        };
+
+        MpscQueue<DebugMessage, DEBUG_MESSAGE_QUEUE_SIZE> queue;
+        std::atomic<VkDebugUtilsMessageSeverityFlagBitsEXT> minSeverity{VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT};
+        std::atomic<uint32_t> rateLimit{DEFAULT_DEBUG_RATE_LIMIT};
+        // Bumped by every push and by stop, the drain thread sleeps on it
+        std::atomic<uint32_t> pushes{0};
+        std::atomic<uint64_t> received{0};
+        std::atomic<uint64_t> processed{0};
+        // Lost because the queue was full
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<bool> stopping{false};
+        std::thread drainThread;
+        // Locked by the drain thread per batch, so that a summary can be written while it runs
+        mutable std::mutex statsMutex;
+        std::unordered_map<std::string, MessageStats> stats;
+
+        void drainLoop();
+        void process(const DebugMessage& message);
+    public:
+        DebugMessageSink() = default;
+        ~DebugMessageSink();
+
+        DebugMessageSink(const DebugMessageSink&) = delete;
+        DebugMessageSink& operator=(const DebugMessageSink&) = delete;
+
+        // Messages pushed before are kept and written once the thread runs
+        void start();
+        void stop();
+
+        // Any thread, never blocks nor allocates. False when the message is filtered out or the queue is full.
+        bool push(
+                VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+                VkDebugUtilsMessageTypeFlagsEXT type,
+                const VkDebugUtilsMessengerCallbackDataEXT* callbackData
+                );
+        // Returns once every message pushed before the call was written
+        void flush();
+
+        // Set before the messenger is created, it only subscribes to the severities that pass
+        void setMinSeverity(VkDebugUtilsMessageSeverityFlagBitsEXT severity);
+        [[nodiscard]]
+        VkDebugUtilsMessageSeverityFlagsEXT getSubscribedSeverities() const;
+        void setRateLimit(uint32_t messagesPerSecond);
+        // "verbose", "info", "warning" or "error"
+        static VkDebugUtilsMessageSeverityFlagBitsEXT parseSeverity(const std::string& name);
+
+        // Totals and the most frequent performance warnings, call after flush()
+        void writeSummary(std::ostream& out, uint32_t topCount = 10) const;
+    };
+
+    DebugMessageSink& getDebugMessageSink();
+
+} // dvk
+
+#endif //DRAFT_VK_DEBUGMESSAGESINK_HPP
@@ -6,11 +6,12 @@
 #define DRAFT_VK_DEVICE_HPP
 
 #include <vulkan/vulkan_core.h>
+#include <memory>
+#include <string>
 #include <vector>
 #include <stdexcept>
 #include "Debug.hpp"
-#include "QueueFamilyIndices.hpp"
-#include "SwapchainSupportDetails.hpp"
+#include "DeviceProfile.hpp"
 #include "ExtentionsUtils.hpp"
 #include "Constants.hpp"
 
@@ -24,8 +25,13 @@ namespace dvk {
         VkDevice device{};
         VkQueue graphicsQueue{};
         VkQueue presentationQueue{};
+        // The graphics queue when the device has no dedicated compute family
+        VkQueue computeQueue{};
+        std::vector<const char*> extensions;
+        // Capabilities of the picked device, optional features are enabled when it supports them
+        std::unique_ptr<DeviceProfile> profile;
 
-        bool isDeviceSuitable(VkPhysicalDevice device);
+        static const DeviceProfile* findRequestedDevice(const std::vector<DeviceProfile>& profiles, const std::string& request);
         void pickPhysicalDevice();
         void createLogicalDevice();
     public:
@@ -36,6 +42,15 @@ namespace dvk {
         VkDevice* getDevice();
         VkQueue* getGraphicsQueue();
         VkQueue* getPresentationQueue();
+        VkQueue* getComputeQueue();
+        const DeviceProfile* getProfile() const;
+        const QueueFamilyIndices* getQueueFamilyIndices() const;
+        [[nodiscard]]
+        bool supportsGpuDrivenRendering() const;
+        [[nodiscard]]
+        bool supportsBindlessDescriptors() const;
+        [[nodiscard]]
+        bool supportsHostQueryReset() const;
     };
 
 } // dvk
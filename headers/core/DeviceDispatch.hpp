@@ -0,0 +1,29 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_DEVICEDISPATCH_HPP
+#define DRAFT_VK_DEVICEDISPATCH_HPP
+
+#include <vulkan/vulkan_core.h>
+#include "ApiCallCounter.hpp"
+
+namespace dvk {
+
+    // Every device function the renderer calls, loaded with vkGetDeviceProcAddr so that calls
+    // skip the loader's trampoline. With the ApiCallCounter enabled each one points at a wrapper that counts (and
+    // for the timed ones times) the call before forwarding it to the driver.
+    // Entry points of extensions the device was created without are null, e.g. the swapchain ones when headless.
+    struct DeviceDispatch {
+#define DVK_DISPATCH_MEMBER(name, timed) PFN_##name name = nullptr;
+        DVK_DEVICE_ENTRY_POINTS(DVK_DISPATCH_MEMBER)
+#undef DVK_DISPATCH_MEMBER
+    };
+
+    // Called once the device is created, the table is shared by every thread
+    void loadDeviceDispatch(VkDevice device);
+    const DeviceDispatch& getDeviceDispatch();
+
+} // dvk
+
+#endif //DRAFT_VK_DEVICEDISPATCH_HPP
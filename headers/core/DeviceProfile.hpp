@@ -0,0 +1,79 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_DEVICEPROFILE_HPP
+#define DRAFT_VK_DEVICEPROFILE_HPP
+
+#include <vulkan/vulkan_core.h>
+#include <cstdint>
+#include <vector>
+#include "QueueFamilyIndices.hpp"
+
+namespace dvk {
+
+    // Everything the renderer asks of a physical device, queried once when devices are enumerated.
+    // The logical device and the objects created from it read the profile instead of querying the driver again.
+    class DeviceProfile {
+    private:
+        VkPhysicalDevice physicalDevice;
+        VkPhysicalDeviceProperties properties{};
+        VkPhysicalDeviceMemoryProperties memoryProperties{};
+        VkPhysicalDeviceFeatures features{};
+        // Left zeroed when the device is older than the version, their pNext are cleared after the query
+        VkPhysicalDeviceVulkan12Features features12{};
+        VkPhysicalDeviceVulkan13Features features13{};
+        std::vector<VkQueueFamilyProperties> queueFamilies;
+        // Per queue family, headless profiles count the graphics families as presenting
+        std::vector<VkBool32> presentationSupport;
+        QueueFamilyIndices queueFamilyIndices;
+        bool extensionsSupported = false;
+        bool swapchainAdequate = false;
+        VkDeviceSize deviceLocalBytes = 0;
+        int64_t score = 0;
+
+        void queryFeatures();
+        void queryQueueFamilies(VkSurfaceKHR surface);
+        void computeScore();
+    public:
+        DeviceProfile(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface, const std::vector<const char*>& extensions);
+
+        // Has the queues, extensions and swapchain support the renderer cannot run without
+        [[nodiscard]]
+        bool isSuitable() const;
+        // Higher is preferred: the device type first, then local memory and the optional features it supports
+        [[nodiscard]]
+        int64_t getScore() const;
+        [[nodiscard]]
+        const char* getName() const;
+        [[nodiscard]]
+        VkDeviceSize getDeviceLocalBytes() const;
+
+        [[nodiscard]]
+        VkPhysicalDevice getPhysicalDevice() const;
+        const VkPhysicalDeviceProperties* getProperties() const;
+        const VkPhysicalDeviceMemoryProperties* getMemoryProperties() const;
+        const VkPhysicalDeviceFeatures* getFeatures() const;
+        const VkPhysicalDeviceVulkan12Features* getFeatures12() const;
+        const VkPhysicalDeviceVulkan13Features* getFeatures13() const;
+        const std::vector<VkQueueFamilyProperties>* getQueueFamilies() const;
+        const QueueFamilyIndices* getQueueFamilyIndices() const;
+
+        // drawIndirectCount, multiDrawIndirect and drawIndirectFirstInstance
+        [[nodiscard]]
+        bool supportsGpuDrivenRendering() const;
+        // Descriptor indexing with partially bound, update-after-bind arrays of images, buffers and samplers
+        [[nodiscard]]
+        bool supportsBindlessDescriptors() const;
+        // Query pools can be reset from the host instead of in a command buffer
+        [[nodiscard]]
+        bool supportsHostQueryReset() const;
+        [[nodiscard]]
+        bool supportsTimelineSemaphores() const;
+        [[nodiscard]]
+        bool supportsSynchronization2() const;
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_DEVICEPROFILE_HPP
@@ -0,0 +1,79 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_DYNAMICRESOLUTION_HPP
+#define DRAFT_VK_DYNAMICRESOLUTION_HPP
+
+#include <vulkan/vulkan_core.h>
+#include <memory>
+#include <vector>
+#include "OffscreenTargets.hpp"
+#include "SwapchainImageViews.hpp"
+#include "RenderPass.hpp"
+#include "Framebuffers.hpp"
+#include "ResourcePools.hpp"
+
+namespace dvk {
+
+    // Renders the scene into a target of a fraction of the output's size, then blits it bilinearly over the whole
+    // output image. The fraction follows the GPU frame time so that it stays within a budget: each frame in flight
+    // has its own full size scene image and only the rendered area changes, so nothing is recreated when the scale
+    // does, only when the output is resized.
+    class DynamicResolution {
+    private:
+        VkPhysicalDevice* physicalDevice;
+        VkDevice* device;
+        VkFormat* targetFormat;
+        std::vector<VkImage>* targetImages;
+        VkExtent2D targetExtent;
+        // Layout the output images are left in for whoever uses them next, e.g. PRESENT_SRC_KHR
+        const VkImageLayout targetFinalLayout;
+        const uint32_t framesInFlight;
+        ResourcePools* resourcePools;
+        const double budgetMilliseconds;
+        const double minScale;
+        double scale = 1.0;
+        // Scale each frame slot was last recorded at, its GPU time comes back when the slot is reused
+        std::vector<double> frameScales;
+        std::vector<VkExtent2D> frameExtents;
+        std::unique_ptr<OffscreenTargets> sceneTargets;
+        std::unique_ptr<SwapchainImageViews> sceneImageViews;
+        std::unique_ptr<RenderPass> renderPass;
+        std::unique_ptr<Framebuffers> framebuffers;
+
+        void checkFormatSupport();
+        void createSceneTargets();
+    public:
+        DynamicResolution(
+                VkPhysicalDevice* physicalDevice,
+                VkDevice* device,
+                VkFormat* targetFormat,
+                std::vector<VkImage>* targetImages,
+                VkExtent2D targetExtent,
+                VkImageLayout targetFinalLayout,
+                uint32_t framesInFlight,
+                double budgetMilliseconds,
+                double minScale,
+                ResourcePools* resourcePools
+                );
+
+        // Adjusts the scale from the GPU time of the frame last recorded in this slot
+        void update(uint32_t frame, double gpuMilliseconds);
+        // Recreates the scene images for resized output images, waits for nothing, the caller idles the device
+        void setTargets(std::vector<VkImage>* targetImages, VkExtent2D targetExtent);
+
+        // Fixes the extent the frame renders at, the area of the scene image the upscale reads
+        VkExtent2D beginFrame(uint32_t frame);
+        // Blits the frame's scene area over the whole output image, after the scene pass ended
+        void recordUpscale(VkCommandBuffer commandBuffer, uint32_t frame, uint32_t imageIndex);
+
+        [[nodiscard]]
+        double getScale() const;
+        VkRenderPass* getRenderPass();
+        std::vector<VkFramebuffer>* getFramebuffers();
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_DYNAMICRESOLUTION_HPP
@@ -0,0 +1,54 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_FRAMECAPTURE_HPP
+#define DRAFT_VK_FRAMECAPTURE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "FrameReadback.hpp"
+
+namespace dvk {
+
+    enum class CaptureFormat {
+        Png,
+        Raw
+    };
+
+    // Writes read back frames to a directory on its own thread, so that encoding and disk writes never hold up a
+    // frame. Each file is named after its frame number; its name and a hash of its pixels are printed to stderr,
+    // deterministic headless runs can be checked against a reference by either.
+    class FrameCapture {
+    private:
+        std::string directory;
+        CaptureFormat format;
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<ReadbackImage> images;
+        bool stopping = false;
+        std::thread writerThread;
+
+        void writeLoop();
+        void write(const ReadbackImage& image);
+    public:
+        // Creates the directory if needed
+        FrameCapture(const std::string& directory, CaptureFormat format);
+        // Writes the images still queued before returning
+        ~FrameCapture();
+
+        FrameCapture(const FrameCapture&) = delete;
+        FrameCapture& operator=(const FrameCapture&) = delete;
+
+        // Any thread, the readback buffer is released once the image is written
+        void submit(ReadbackImage image);
+
+        static CaptureFormat parseCaptureFormat(const std::string& format);
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_FRAMECAPTURE_HPP
@@ -0,0 +1,34 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_FRAMEPACER_HPP
+#define DRAFT_VK_FRAMEPACER_HPP
+
+#include <chrono>
+
+namespace dvk {
+
+    // Starts frames at a fixed rate, whatever the present mode lets through. Sleeps until shortly before the next
+    // frame's start and spins the rest of the way, the margin left to the spin follows how late the OS scheduler
+    // wakes the thread up. A frame that started a whole period late restarts the schedule instead of bursting, its
+    // lateness is still reported.
+    class FramePacer {
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        const Clock::duration period;
+        Clock::time_point lastStart{};
+        Clock::duration spinMargin;
+    public:
+        explicit FramePacer(double targetFramesPerSecond);
+
+        // Blocks until the next frame may start, returns how late it starts in seconds
+        double wait();
+        // After an idle period, e.g. an on-demand wait: the next frame starts at once, on a new schedule, and reports 0
+        void reset();
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_FRAMEPACER_HPP
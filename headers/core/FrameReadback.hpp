@@ -0,0 +1,101 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_FRAMEREADBACK_HPP
+#define DRAFT_VK_FRAMEREADBACK_HPP
+
+#include <vulkan/vulkan_core.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace dvk {
+
+    // Pixels of a frame read back from the GPU, tightly packed rows in the format of the target images.
+    // Keeps its buffer of the readback ring busy until destroyed, so it can be moved to another thread to be
+    // written out without a copy.
+    class ReadbackImage {
+    private:
+        std::atomic<bool>* held = nullptr;
+    public:
+        const uint8_t* pixels = nullptr;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t rowPitch = 0;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        uint64_t frameNumber = 0;
+
+        ReadbackImage() = default;
+        explicit ReadbackImage(std::atomic<bool>* held);
+        ~ReadbackImage();
+
+        ReadbackImage(ReadbackImage&& other) noexcept;
+        ReadbackImage& operator=(ReadbackImage&& other) noexcept;
+        ReadbackImage(const ReadbackImage&) = delete;
+        ReadbackImage& operator=(const ReadbackImage&) = delete;
+    };
+
+    using ReadbackCallback = std::function<void(ReadbackImage image)>;
+
+    // Copies requested target images into a ring of persistently mapped host cached buffers at the end of the frame's
+    // commands, and hands them to their callback once the frame's fence was waited on, frames in flight later.
+    // Nothing waits on the GPU for it. A request made while every buffer is still held waits for the next frame.
+    // Render thread only, but for the release of the images.
+    class FrameReadback {
+    private:
+        struct Buffer {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            VkDeviceSize capacity = 0;
+            uint8_t* mapped = nullptr;
+            // From the copy being recorded until the image handed out is destroyed
+            std::atomic<bool> held{false};
+        };
+
+        struct FrameCopy {
+            Buffer* buffer = nullptr;
+            VkExtent2D extent{};
+            uint64_t frameNumber = 0;
+            ReadbackCallback callback;
+        };
+
+        VkPhysicalDevice* physicalDevice;
+        VkDevice* device;
+        VkFormat format;
+        // Layout the target images are left in by the frame, restored after the copy
+        VkImageLayout targetLayout;
+        uint32_t bytesPerPixel;
+        std::vector<std::unique_ptr<Buffer>> buffers;
+        std::vector<FrameCopy> frames;
+        std::vector<ReadbackCallback> requests;
+        uint64_t frameNumber = 0;
+
+        void destroyBuffer(Buffer& buffer);
+        void createBuffer(Buffer& buffer, VkDeviceSize size);
+        Buffer* findFreeBuffer();
+        void collect(uint32_t frame);
+    public:
+        FrameReadback(VkPhysicalDevice* physicalDevice, VkDevice* device, VkFormat format, VkImageLayout targetLayout, uint32_t framesInFlight);
+        ~FrameReadback();
+
+        // Once the frame's fence was waited on: calls the callback of the copy recorded in it, if any, on this thread
+        void beginFrame(uint32_t frame, uint64_t frameNumber);
+        // Reads back the next frame recorded
+        void request(ReadbackCallback callback);
+        // After the frame's draws and upscale, the image is the frame's target image
+        void record(VkCommandBuffer commandBuffer, uint32_t frame, VkImage image, VkExtent2D extent);
+        // Once the device is idle, e.g. for the copy of the last frame drawn
+        void collectAll();
+
+        // Bytes per pixel of the formats the target images can have, throws on others
+        static uint32_t getBytesPerPixel(VkFormat format);
+        // Whether the red and blue channels are swapped compared to RGBA
+        static bool isBgra(VkFormat format);
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_FRAMEREADBACK_HPP
@@ -0,0 +1,105 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_GPUSCENE_HPP
+#define DRAFT_VK_GPUSCENE_HPP
+
+#include <vulkan/vulkan_core.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+#include "Vertex.hpp"
+#include "InstanceData.hpp"
+#include "ResourcePools.hpp"
+#include "ComputePipeline.hpp"
+#include "Metrics.hpp"
+#include "UniformRing.hpp"
+
+namespace dvk {
+
+    // Layouts shared with resources/shaders/cull.comp (std430)
+    struct GpuObject {
+        uint32_t mesh;
+        uint32_t batch;
+    };
+
+    struct GpuMesh {
+        // xy center, zw half extent, in the mesh's local space
+        glm::vec4 bounds;
+        uint32_t vertexCount;
+        uint32_t firstVertex;
+        uint32_t padding[2];
+    };
+
+    // Scene kept in GPU buffers and drawn without per-object CPU work: every frame a compute pass culls the objects
+    // against the view and appends a VkDrawIndirectCommand per visible object to its batch, then each batch (one
+    // pipeline) is drawn with a single vkCmdDrawIndirectCount. Objects are only appended, entries read by frames in
+    // flight are never rewritten.
+    class GpuScene {
+    private:
+        struct SceneBuffer {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            void* mapped = nullptr;
+            BufferHandle handle;
+        };
+
+        VkPhysicalDevice* physicalDevice;
+        VkDevice* device;
+        ResourcePools* resourcePools;
+        const uint32_t objectCapacity;
+        const uint32_t batchCapacity;
+        const uint32_t framesInFlight;
+        uint32_t objectCount = 0;
+        // Every mesh of the scene lives in this buffer, it is bound once for all batches
+        BufferHandle vertexBuffer;
+        std::vector<PipelineHandle> batches;
+        uint32_t meshCount = 0;
+        // Binding 1 of the instanced pipeline and read by the culling shader
+        SceneBuffer instances;
+        SceneBuffer objects;
+        SceneBuffer meshes;
+        // One slice per frame in flight, objectCapacity commands and one count per batch
+        SceneBuffer commands;
+        SceneBuffer counts;
+        // Queue families accessing the buffers, more than one makes them concurrently shared
+        std::vector<uint32_t> queueFamilies;
+        VkDescriptorSet descriptorSet{};
+        std::unique_ptr<ComputePipeline> cullPipeline;
+        metrics::RendererMetrics* rendererMetrics;
+
+        void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, bool hostVisible, SceneBuffer& sceneBuffer);
+        void destroyBuffer(SceneBuffer& sceneBuffer);
+        void createDescriptors();
+    public:
+        // Culling may run on another queue family than the draws, list both in `queueFamilies` then
+        GpuScene(
+                VkPhysicalDevice* physicalDevice,
+                VkDevice* device,
+                uint32_t objectCapacity,
+                uint32_t batchCapacity,
+                uint32_t framesInFlight,
+                std::vector<uint32_t> queueFamilies,
+                ResourcePools* resourcePools
+                );
+        ~GpuScene();
+
+        // Bounds are computed from the mesh's range of `vertices`, the contents of its vertex buffer
+        uint32_t addMesh(MeshHandle mesh, const std::vector<Vertex>& vertices);
+        // Objects of a batch are drawn with this pipeline, it must take InstanceData on binding 1
+        uint32_t addBatch(PipelineHandle pipeline);
+        uint32_t addObject(uint32_t mesh, uint32_t batch, const InstanceData& instance);
+
+        // Outside of a render pass, before the frame's recordDraws, on the graphics queue or a compute queue
+        void recordCulling(VkCommandBuffer commandBuffer, uint32_t frame);
+        // Returns the number of indirect draws recorded, one per batch. Batches draw with identity uniforms from the ring.
+        uint32_t recordDraws(VkCommandBuffer commandBuffer, uint32_t frame, UniformRing* uniformRing);
+
+        [[nodiscard]]
+        uint32_t getObjectCount() const;
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_GPUSCENE_HPP
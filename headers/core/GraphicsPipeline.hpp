@@ -7,26 +7,41 @@
 
 #include <vulkan/vulkan_core.h>
 #include <vector>
+#include "ResourcePools.hpp"
+#include "BindlessDescriptors.hpp"
+#include "UniformRing.hpp"
 
 namespace dvk {
 
     class GraphicsPipeline {
     private:
         VkPipelineLayout pipelineLayout{};
+        // Stands in for set 0 without bindless descriptors, so the draw uniforms stay at DRAW_UNIFORMS_SET
+        VkDescriptorSetLayout emptySetLayout{};
         VkPipeline graphicsPipeline{};
         VkShaderModule vertShaderModule{};
         VkShaderModule fragShaderModule{};
         VkDevice* device;
         VkRenderPass* renderPass;
         VkExtent2D* swapChainExtent;
+        ResourcePools* resourcePools;
+        // Set 0 and the push constants of the layout when set
+        BindlessDescriptors* bindlessDescriptors;
+        // Set 1 of the layout when set
+        UniformRing* uniformRing;
+        PipelineHandle pipelineHandle;
+        // Adds the per-instance binding and its shader
+        bool instanced;
 
         VkShaderModule createShaderModule(const std::vector<char>& code);
+        void createPipelineLayout();
         void createGraphicsPipeline();
     public:
-        GraphicsPipeline(VkDevice *device, VkRenderPass *renderPass, VkExtent2D *swapChainExtent);
+        GraphicsPipeline(VkDevice *device, VkRenderPass *renderPass, VkExtent2D *swapChainExtent, ResourcePools* resourcePools, BindlessDescriptors* bindlessDescriptors, UniformRing* uniformRing, bool instanced = false);
         ~GraphicsPipeline();
 
         VkPipeline* getGraphicsPipeline();
+        PipelineHandle getPipelineHandle() const;
     };
 
 } // dvk
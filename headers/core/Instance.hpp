@@ -16,10 +16,11 @@ namespace dvk {
     private:
         VkApplicationInfo appInfo{};
         VkInstance instance{};
+        bool headless;
 
         void init();
     public:
-        Instance();
+        explicit Instance(bool headless = false);
         ~Instance();
 
         [[nodiscard]]
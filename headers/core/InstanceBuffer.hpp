@@ -0,0 +1,62 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_INSTANCEBUFFER_HPP
+#define DRAFT_VK_INSTANCEBUFFER_HPP
+
+#include <vulkan/vulkan_core.h>
+#include <vector>
+#include "InstanceData.hpp"
+#include "ResourcePools.hpp"
+
+namespace dvk {
+
+    // One vkCmdDraw: instanceCount instances of a mesh, starting at firstInstance in the frame's slice of the ring
+    struct InstancedDraw {
+        MeshHandle mesh;
+        uint32_t firstInstance = 0;
+        uint32_t instanceCount = 0;
+    };
+
+    // Persistently mapped ring of per-instance data, one slice of `capacity` instances per frame in flight.
+    // Instances are written straight into the mapped memory every frame, no staging copy.
+    class InstanceBuffer {
+    private:
+        struct FrameInstances {
+            uint32_t count = 0;
+            std::vector<InstancedDraw> draws;
+        };
+
+        VkPhysicalDevice* physicalDevice;
+        VkDevice* device;
+        ResourcePools* resourcePools;
+        const uint32_t capacity;
+        const uint32_t framesInFlight;
+        VkBuffer buffer{};
+        VkDeviceMemory bufferMemory{};
+        InstanceData* mapped = nullptr;
+        BufferHandle bufferHandle;
+        std::vector<FrameInstances> frames;
+
+        void createBuffer();
+    public:
+        InstanceBuffer(VkPhysicalDevice* physicalDevice, VkDevice* device, uint32_t capacity, uint32_t framesInFlight, ResourcePools* resourcePools);
+        ~InstanceBuffer();
+
+        // The frame's fence must have been waited on, its slice is about to be overwritten
+        void beginFrame(uint32_t frame);
+        // Returns where to write `count` instances of the mesh, consecutive allocations of one mesh share a draw
+        InstanceData* allocate(uint32_t frame, MeshHandle mesh, uint32_t count);
+
+        std::vector<InstancedDraw>* getDraws(uint32_t frame);
+        VkBuffer* getBuffer();
+        [[nodiscard]]
+        VkDeviceSize getFrameOffset(uint32_t frame) const;
+        [[nodiscard]]
+        uint32_t getCapacity() const;
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_INSTANCEBUFFER_HPP
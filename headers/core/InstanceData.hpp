@@ -0,0 +1,68 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_INSTANCEDATA_HPP
+#define DRAFT_VK_INSTANCEDATA_HPP
+
+#include <glm/glm.hpp>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include "vulkan/vulkan.hpp"
+
+namespace dvk {
+
+    // Per-instance vertex attributes, read from binding 1 once per instance
+    struct InstanceData {
+        // xy offset, zw scale
+        glm::vec4 transform;
+        glm::vec4 color;
+
+        static VkVertexInputBindingDescription getBindingDescription() {
+            VkVertexInputBindingDescription bindingDescription{};
+            bindingDescription.binding = 1;
+            bindingDescription.stride = sizeof(InstanceData);
+            bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+            return bindingDescription;
+        }
+
+        static std::array<VkVertexInputAttributeDescription, 2> getAttributeDescription() {
+            std::array<VkVertexInputAttributeDescription, 2> attributeDescription{};
+            attributeDescription[0].binding = 1;
+            attributeDescription[0].location = 2;
+            attributeDescription[0].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+            attributeDescription[0].offset = offsetof(InstanceData, transform);
+
+            attributeDescription[1].binding = 1;
+            attributeDescription[1].location = 3;
+            attributeDescription[1].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+            attributeDescription[1].offset = offsetof(InstanceData, color);
+
+            return attributeDescription;
+        }
+    };
+
+    // Lays count copies of the mesh out on a square grid spanning [-span, span] on both axes, the instanced and the
+    // GPU-driven paths share it. Calls write(index, u, v, transform) per instance, u and v are the cell's center in [0, 1].
+    template<typename F>
+    void layoutInstanceGrid(uint32_t count, float span, F&& write)
+    {
+        auto columns = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+        float cell = 1.0f / static_cast<float>(columns);
+        float scale = cell * span * 1.6f;
+
+        uint32_t index = 0;
+        for (uint32_t row = 0; row < columns && index < count; row++) {
+            float v = (static_cast<float>(row) + 0.5f) * cell;
+            for (uint32_t column = 0; column < columns && index < count; column++, index++) {
+                float u = (static_cast<float>(column) + 0.5f) * cell;
+                write(index, u, v, glm::vec4((u * 2.0f - 1.0f) * span, (v * 2.0f - 1.0f) * span, scale, scale));
+            }
+        }
+    }
+
+} // dvk
+
+#endif //DRAFT_VK_INSTANCEDATA_HPP
@@ -0,0 +1,92 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_MPSCQUEUE_HPP
+#define DRAFT_VK_MPSCQUEUE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace dvk {
+
+    // Fixed capacity lock-free queue, any thread pushes and one thread pops (Vyukov's bounded queue).
+    // Every cell carries a sequence number telling whether it is free for the push at its position or holds the value
+    // for the pop at its position. Values are written and read in place, a full queue makes push fail.
+    template<typename T, uint64_t Capacity>
+    class MpscQueue {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    private:
+        struct Cell {
+            std::atomic<uint64_t> sequence{0};
+            T value{};
+        };
+
+        std::unique_ptr<Cell[]> cells;
+        alignas(64) std::atomic<uint64_t> tail{0};
+        // Consumer only
+        alignas(64) uint64_t head = 0;
+    public:
+        MpscQueue() : cells(std::make_unique<Cell[]>(Capacity))
+        {
+            for (uint64_t i = 0; i < Capacity; i++)
+            {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        // Any thread, write(T&) fills the claimed cell
+        template<typename F>
+        bool push(F&& write)
+        {
+            uint64_t position = tail.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;)
+            {
+                cell = &cells[position & (Capacity - 1)];
+                uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+                auto difference = static_cast<int64_t>(sequence - position);
+                if (difference == 0)
+                {
+                    if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    // The cell still holds the value pushed a lap ago
+                    return false;
+                }
+                else
+                {
+                    position = tail.load(std::memory_order_relaxed);
+                }
+            }
+
+            write(cell->value);
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer only, read(T&) sees the oldest value, which is released once it returns
+        template<typename F>
+        bool pop(F&& read)
+        {
+            Cell& cell = cells[head & (Capacity - 1)];
+            if (cell.sequence.load(std::memory_order_acquire) != head + 1)
+            {
+                return false;
+            }
+
+            read(cell.value);
+            cell.sequence.store(head + Capacity, std::memory_order_release);
+            head++;
+            return true;
+        }
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_MPSCQUEUE_HPP
@@ -0,0 +1,43 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_OFFSCREENTARGETS_HPP
+#define DRAFT_VK_OFFSCREENTARGETS_HPP
+
+#include <vulkan/vulkan_core.h>
+#include <vector>
+#include "ResourcePools.hpp"
+
+namespace dvk {
+
+    // Stand-in for the swapchain in headless mode: a ring of device local color images
+    // that are rendered to and never presented. Also the scene targets of dynamic resolution.
+    class OffscreenTargets {
+    private:
+        std::vector<VkImage> images;
+        std::vector<VkDeviceMemory> imageMemories;
+        std::vector<ImageHandle> imageHandles;
+        VkFormat imageFormat{};
+        VkExtent2D extent{};
+        VkPhysicalDevice* physicalDevice;
+        VkDevice* device;
+        uint32_t imageCount;
+        ResourcePools* resourcePools;
+
+        VkFormat chooseImageFormat();
+        void createImages();
+    public:
+        // VK_FORMAT_UNDEFINED picks the first supported of the swapchain's preferred formats
+        OffscreenTargets(VkPhysicalDevice* physicalDevice, VkDevice* device, VkExtent2D extent, uint32_t imageCount, ResourcePools* resourcePools, VkFormat format = VK_FORMAT_UNDEFINED);
+        ~OffscreenTargets();
+
+        std::vector<VkImage>* getImages();
+        VkFormat* getImageFormat();
+        VkExtent2D* getExtent();
+        std::vector<ImageHandle>* getImageHandles();
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_OFFSCREENTARGETS_HPP
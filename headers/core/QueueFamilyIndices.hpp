@@ -5,7 +5,6 @@
 #include <cstdint>
 #include <vulkan/vulkan_core.h>
 #include <vector>
-#include "Device.hpp"
 
 namespace dvk {
 
@@ -14,16 +13,28 @@ namespace dvk {
     private:
         std::optional<uint32_t> graphicsFamily;
         std::optional<uint32_t> presentationFamily;
+        // A compute family without graphics when the device has one, else the graphics family
+        std::optional<uint32_t> computeFamily;
+        bool dedicatedComputeFamily = false;
 
-        void findQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface);
+        void findQueueFamilies(const std::vector<VkQueueFamilyProperties>& queueFamilies, const std::vector<VkBool32>& presentationSupport);
     public:
-        explicit QueueFamilyIndices(VkPhysicalDevice* device, VkSurfaceKHR* surface);
+        QueueFamilyIndices() = default;
+        // From a device's queue families and whether each can present, as cached by its DeviceProfile
+        QueueFamilyIndices(const std::vector<VkQueueFamilyProperties>& queueFamilies, const std::vector<VkBool32>& presentationSupport);
 
         [[nodiscard]]
         bool isComplete() const;
 
-        uint32_t getGraphicsFamilyValue();
-        uint32_t getPresentationFamilyValue();
+        [[nodiscard]]
+        uint32_t getGraphicsFamilyValue() const;
+        [[nodiscard]]
+        uint32_t getPresentationFamilyValue() const;
+        [[nodiscard]]
+        uint32_t getComputeFamilyValue() const;
+        // Work submitted to the compute family runs on other hardware queues than graphics
+        [[nodiscard]]
+        bool hasDedicatedComputeFamily() const;
     };
 }
 
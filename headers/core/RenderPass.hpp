@@ -14,10 +14,11 @@ namespace dvk {
         VkRenderPass renderPass{};
         VkDevice* device;
         VkFormat* swapchainImageFormat;
+        VkImageLayout finalLayout;
 
         void createRenderPass();
     public:
-        RenderPass(VkDevice* device, VkFormat* swapchainImageFormat);
+        RenderPass(VkDevice* device, VkFormat* swapchainImageFormat, VkImageLayout finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
         ~RenderPass();
 
         VkRenderPass* getRenderPass();
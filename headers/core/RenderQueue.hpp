@@ -0,0 +1,70 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_RENDERQUEUE_HPP
+#define DRAFT_VK_RENDERQUEUE_HPP
+
+#include <cstdint>
+#include <vector>
+#include "ResourcePools.hpp"
+#include "ParallelExecutor.hpp"
+
+namespace dvk {
+
+    struct DrawPacket {
+        PipelineHandle pipeline;
+        MeshHandle mesh;
+        uint32_t material = 0;
+        uint32_t pass = 0;
+        bool transparent = false;
+        // Normalized view depth, 0 is the nearest
+        float depth = 0.0f;
+        uint32_t firstInstance = 0;
+        uint32_t instanceCount = 1;
+        // Dynamic offset of the draw's block in the frame's uniform ring
+        uint32_t uniformOffset = 0;
+    };
+
+    // Draw packets ordered by a 64-bit key, most significant bits first:
+    //   opaque:      pass:4 | 0 | pipeline:12 | material:12 | mesh:12 | depth:23 (front to back)
+    //   transparent: pass:4 | 1 | inverted depth:23 (back to front) | pipeline:12 | material:12 | mesh:12
+    // Opaque draws group by state to minimize binds, transparent ones after them in blending order.
+    // Pipelines and meshes are keyed by their slot index, collisions past 4096 only cost extra binds.
+    class RenderQueue {
+    private:
+        struct SortEntry {
+            uint64_t key;
+            uint32_t packet;
+        };
+
+        std::vector<DrawPacket> packets;
+        std::vector<SortEntry> entries;
+        std::vector<SortEntry> scratch;
+        // Bits set in every key and in any key, a radix pass over a byte that never varies is skipped
+        uint64_t keysAnd = ~0ull;
+        uint64_t keysOr = 0;
+        ParallelExecutor* executor;
+
+        void radixSort();
+    public:
+        explicit RenderQueue(ParallelExecutor* executor = nullptr);
+
+        void clear();
+        void submit(const DrawPacket& packet);
+        void sort();
+
+        [[nodiscard]]
+        uint32_t size() const;
+        // Valid after sort, the i-th packet in draw order
+        [[nodiscard]]
+        const DrawPacket& getSorted(uint32_t index) const;
+
+        void setExecutor(ParallelExecutor* executor);
+
+        static uint64_t makeSortKey(const DrawPacket& packet);
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_RENDERQUEUE_HPP
@@ -0,0 +1,25 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_SCENESNAPSHOT_HPP
+#define DRAFT_VK_SCENESNAPSHOT_HPP
+
+#include <cstdint>
+
+namespace dvk {
+
+    // Simulation state published by the event loop, everything a frame reads from it. Copied by value into a
+    // triple buffer, so it must stay trivially copyable and small.
+    struct SceneSnapshot {
+        // Incremented by each published snapshot
+        uint64_t sequence = 0;
+        // Seconds of simulated time
+        double time = 0.0;
+        // Brightness of the instance colors, from 0 to 1
+        float pulse = 0.5f;
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_SCENESNAPSHOT_HPP
@@ -0,0 +1,79 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_STARTUPGRAPH_HPP
+#define DRAFT_VK_STARTUPGRAPH_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+#include "JobSystem.hpp"
+
+namespace dvk {
+
+    // The stages that build the renderer, each started on the job system as soon as the stages it depends on are
+    // done, so that independent work (e.g. uploading vertices and compiling pipelines) overlaps. Stages that must run
+    // on the main thread, like GLFW window creation, are run by the thread calling run() while it helps with jobs.
+    // Stages share no state but what their dependencies built: two stages touching the same object, a resource
+    // pool or a queue, must depend on one another.
+    class StartupGraph {
+    public:
+        using Clock = std::chrono::steady_clock;
+        // Stands for a stage that was not added, ignored in dependency lists
+        static constexpr uint32_t NO_STAGE = UINT32_MAX;
+    private:
+        struct Stage {
+            const char* name;
+            std::function<void()> body;
+            bool mainThread;
+            std::vector<uint32_t> dependents;
+            uint32_t dependencyCount = 0;
+            std::atomic<uint32_t> remainingDependencies{0};
+            Clock::time_point begin{};
+            Clock::time_point end{};
+            bool ranOnMainThread = false;
+        };
+
+        jobs::JobSystem* jobSystem;
+        std::vector<std::unique_ptr<Stage>> stages;
+        bool parallel = true;
+        std::atomic<uint32_t> completedStages{0};
+        // Once a stage threw, the ones left are skipped and run() rethrows the first error
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex mainThreadMutex;
+        std::vector<uint32_t> mainThreadStages;
+        std::thread::id mainThread;
+        Clock::time_point begin{};
+        Clock::time_point end{};
+
+        static void runStage(void* context, uint32_t begin, uint32_t end);
+        void schedule(uint32_t index);
+        void execute(uint32_t index);
+        bool popMainThreadStage(uint32_t& index);
+    public:
+        explicit StartupGraph(jobs::JobSystem* jobSystem);
+
+        // Dependencies must have been added before, so that the order of addition is a valid serial order
+        uint32_t add(const char* name, std::vector<uint32_t> dependencies, std::function<void()> body, bool mainThread = false);
+        // Runs every stage, on the job system or one after the other on the calling thread, which must be the
+        // job system's worker 0. Rethrows the first exception a stage threw.
+        void run(bool parallel);
+
+        [[nodiscard]]
+        double getMilliseconds() const;
+        // Per-stage start and end relative to the start of run(), and the time from processStart to firstFrame, as JSON
+        void writeReport(std::ostream& out, Clock::time_point processStart, Clock::time_point firstFrame) const;
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_STARTUPGRAPH_HPP
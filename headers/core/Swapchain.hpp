@@ -7,7 +7,8 @@
 
 #include <vulkan/vulkan_core.h>
 #include <vector>
-#include <GLFW/glfw3.h>
+#include "Window.hpp"
+#include "QueueFamilyIndices.hpp"
 
 namespace dvk {
 
@@ -17,22 +18,29 @@ namespace dvk {
         std::vector<VkImage> swapChainImages;
         VkFormat swapChainImageFormat{};
         VkExtent2D swapChainExtent{};
-        GLFWwindow* window;
+        VkImageUsageFlags imageUsage{};
+        Window* window;
         VkSurfaceKHR* surface;
         VkPhysicalDevice* physicalDevice;
         VkDevice* device;
+        const QueueFamilyIndices* queueFamilyIndices;
 
-        VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats);
+        static VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats);
         VkPresentModeKHR chooseSwapPresentMode(std::vector<VkPresentModeKHR> availablePresentModes);
         VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities);
         void createSwapChain();
     public:
-        Swapchain(GLFWwindow* window, VkSurfaceKHR* surface, VkPhysicalDevice* physicalDevice, VkDevice* device);
+        Swapchain(Window* window, VkSurfaceKHR* surface, VkPhysicalDevice* physicalDevice, VkDevice* device, const QueueFamilyIndices* queueFamilyIndices);
         ~Swapchain();
 
+        // Format the swapchain of this surface will have, so that the render pass can be built before it
+        static VkFormat chooseImageFormat(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface);
+
         std::vector<VkImage>* getSwapchainImages();
         VkFormat* getSwapchainImageFormat();
         VkExtent2D* getSwapchainExtent();
+        [[nodiscard]]
+        VkImageUsageFlags getImageUsage() const;
 
         VkSwapchainKHR* getSwapChain();
     };
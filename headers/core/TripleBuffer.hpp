@@ -0,0 +1,59 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_TRIPLEBUFFER_HPP
+#define DRAFT_VK_TRIPLEBUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace dvk {
+
+    // Lock-free handoff of the latest value from one writer thread to one reader thread. The writer fills its back
+    // slot and swaps it with the middle one, the reader swaps the middle slot with its front one when it holds a newer
+    // value. Neither side ever waits, the reader may skip values and sees the same one again until a newer is published.
+    template<typename T>
+    class TripleBuffer {
+    private:
+        static constexpr uint8_t INDEX_MASK = 3;
+        // Set in middle when its slot was published since the reader last took it
+        static constexpr uint8_t FRESH_BIT = 4;
+
+        T slots[3]{};
+        alignas(64) std::atomic<uint8_t> middle{1};
+        // Owned by the writer and the reader respectively, kept on separate cache lines
+        alignas(64) uint8_t back = 0;
+        alignas(64) uint8_t front = 2;
+    public:
+        // Writer only, the slot holds an older value and must be written entirely
+        T& getWriteSlot() {
+            return slots[back];
+        }
+
+        // Writer only
+        void publish() {
+            uint8_t previous = middle.exchange(back | FRESH_BIT, std::memory_order_acq_rel);
+            back = previous & INDEX_MASK;
+        }
+
+        // Reader only, returns false and keeps the current value when nothing newer was published
+        bool acquire() {
+            if ((middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0)
+            {
+                return false;
+            }
+            uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+            front = previous & INDEX_MASK;
+            return true;
+        }
+
+        // Reader only, valid until the next acquire
+        const T& getReadSlot() const {
+            return slots[front];
+        }
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_TRIPLEBUFFER_HPP
@@ -0,0 +1,74 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_UNIFORMRING_HPP
+#define DRAFT_VK_UNIFORMRING_HPP
+
+#include <vulkan/vulkan_core.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace dvk {
+
+    // Set of the per-draw uniforms in every graphics pipeline layout, set 0 is the bindless set or an empty one
+    constexpr uint32_t DRAW_UNIFORMS_SET = 1;
+    constexpr VkDeviceSize DEFAULT_UNIFORM_RING_SIZE = 1024 * 1024;
+
+    // Per-draw block of resources/shaders/instanced.vert
+    struct DrawUniforms {
+        // xy offset, zw scale, applied after the instance transform
+        glm::vec4 transform;
+        glm::vec4 color;
+    };
+
+    // One persistently mapped uniform buffer per frame in flight, bump allocated in steps of
+    // minUniformBufferOffsetAlignment. Each frame has one descriptor set with a UNIFORM_BUFFER_DYNAMIC binding over its
+    // buffer, a draw binds it with the offset of its block, so fresh per-draw constants cost no descriptor write.
+    class UniformRing {
+    private:
+        struct FrameBuffer {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            char* mapped = nullptr;
+            VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+            VkDeviceSize head = 0;
+        };
+
+        VkPhysicalDevice* physicalDevice;
+        VkDevice* device;
+        const VkDeviceSize capacity;
+        // Range of the descriptor, the largest block a draw can read
+        const VkDeviceSize blockSize;
+        VkDeviceSize alignment = 0;
+        std::vector<FrameBuffer> frames;
+        VkDescriptorSetLayout descriptorSetLayout{};
+        VkDescriptorPool descriptorPool{};
+
+        void createBuffers();
+        void createDescriptors();
+    public:
+        UniformRing(VkPhysicalDevice* physicalDevice, VkDevice* device, uint32_t framesInFlight, VkDeviceSize capacity, VkDeviceSize blockSize);
+        ~UniformRing();
+
+        // The frame's fence must have been waited on, its buffer is about to be overwritten
+        void beginFrame(uint32_t frame);
+        // Returns where to write `size` bytes, their dynamic offset is written to `offset`
+        void* allocate(uint32_t frame, VkDeviceSize size, uint32_t& offset);
+
+        template<typename T>
+        T* allocate(uint32_t frame, uint32_t& offset) {
+            return static_cast<T*>(allocate(frame, sizeof(T), offset));
+        }
+
+        // Binds the frame's set at DRAW_UNIFORMS_SET of a layout created with getDescriptorSetLayout
+        void bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frame, uint32_t offset);
+
+        VkDescriptorSetLayout* getDescriptorSetLayout();
+        [[nodiscard]]
+        VkDeviceSize getAlignment() const;
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_UNIFORMRING_HPP
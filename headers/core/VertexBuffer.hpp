@@ -7,6 +7,8 @@
 
 #include <vulkan/vulkan.h>
 #include "Vertex.hpp"
+#include "ResourcePools.hpp"
+#include "QueueFamilyIndices.hpp"
 
 namespace dvk {
 
@@ -15,7 +17,10 @@ namespace dvk {
         VkDevice* device;
         VkPhysicalDevice* physicalDevice;
         VkQueue* graphicsQueue;
-        VkSurfaceKHR* surface;
+        const QueueFamilyIndices* queueFamilyIndices;
+        ResourcePools* resourcePools;
+        BufferHandle bufferHandle;
+        MeshHandle meshHandle;
         VkBuffer stagingBuffer{};
         VkDeviceMemory stagingBufferMemory{};
         VkBuffer vertexBuffer{};
@@ -35,13 +40,15 @@ namespace dvk {
                 VkDeviceMemory& bufferMemory
                 );
         void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
+        void registerResources(VkDeviceSize size);
     public:
-        VertexBuffer(VkDevice* device, VkPhysicalDevice* physicalDevice, VkQueue* graphicsQueue, VkSurfaceKHR* surface);
-        VertexBuffer(VkDevice* device, VkPhysicalDevice* physicalDevice, std::vector<Vertex> vertices, VkQueue* graphicsQueue, VkSurfaceKHR* surface);
+        VertexBuffer(VkDevice* device, VkPhysicalDevice* physicalDevice, VkQueue* graphicsQueue, const QueueFamilyIndices* queueFamilyIndices, ResourcePools* resourcePools);
+        VertexBuffer(VkDevice* device, VkPhysicalDevice* physicalDevice, std::vector<Vertex> vertices, VkQueue* graphicsQueue, const QueueFamilyIndices* queueFamilyIndices, ResourcePools* resourcePools);
         ~VertexBuffer();
 
         VkBuffer* getVertexBuffer();
         std::vector<Vertex>* getVertices();
+        MeshHandle getMeshHandle() const;
     };
 
 } // dvk
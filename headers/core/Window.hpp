@@ -5,6 +5,7 @@
 #ifndef DRAFT_VK_WINDOW_HPP
 #define DRAFT_VK_WINDOW_HPP
 
+#include <atomic>
 #include <memory>
 #include <GLFW/glfw3.h>
 #include <vector>
@@ -26,31 +27,66 @@ namespace dvk {
         const uint32_t HEIGHT;
         const uint32_t WIDTH;
         uint32_t nbFrames{};
-        double lastTime;
-        bool framebufferResized;
+        double lastTime{};
+        // Written by the render thread, read by the event loop
+        std::atomic<uint32_t> renderedFrames{0};
+        std::atomic<double> gpuFrameTime{0.0};
+        std::atomic<double> pacingErrors{0.0};
+        // Whether frames are paced, the title only shows the pacing error then
+        bool paced = false;
+        // Written by the event loop from the GLFW callbacks, read by the render thread, which cannot call GLFW
+        std::atomic<bool> framebufferResized;
+        // Width in the high 32 bits, height in the low ones, so that both are read at once
+        std::atomic<uint64_t> framebufferSize{0};
+        // Set by input, resize and expose events, the first frame is always drawn
+        std::atomic<bool> redrawRequested{true};
+        // Set by F12
+        std::atomic<bool> screenshotRequested{false};
         std::unique_ptr<GLFWwindow, DestroyGLFWwindow> window;
 
+        static Window* fromRawWindow(GLFWwindow* window);
         void createWindow(const std::vector<WindowHint>& windowHints);
         void showStats();
     public:
-        Window();
+        Window(uint32_t width, uint32_t height);
         ~Window();
 
+        // GLFW is initialized by the first window, or ahead of it so that other threads can query its extensions
+        static void initGlfw();
+
         [[nodiscard]]
         GLFWwindow* getRawWindow();
         [[nodiscard]]
         bool isFramebufferResized() const;
         void setFramebufferResized(bool framebufferResized);
+        // Last size reported by GLFW, safe to call from any thread
+        void getFramebufferSize(uint32_t& width, uint32_t& height) const;
+        void requestClose();
+        // Wakes the event loop up, safe to call from any thread
+        void wakeUp();
+        void setGpuFrameTime(double gpuFrameTime);
+        void addRenderedFrame();
+        void addPacingError(double pacingError);
+        // Before the event loop starts
+        void setPaced(bool paced);
+        void requestRedraw();
+        // Whether an event asked for a redraw since the last call
+        bool consumeRedrawRequest();
+        // Whether F12 was pressed since the last call
+        bool consumeScreenshotRequest();
         static void framebufferResizeCallback(GLFWwindow* window, int width, int height);
 
+        // Handles events on the calling thread until the window is closed. cb runs after each batch of events and
+        // returns the longest time in seconds to wait for the next one.
         template<typename Lambda>
         void startLoop(Lambda&& cb, bool showStats) {
+            double timeout = 0.0;
             while (!glfwWindowShouldClose(this->window.get()))
             {
                 if (showStats)
                     this->showStats();
-                glfwPollEvents();
-                cb();
+                glfwWaitEventsTimeout(timeout);
+                timeout = cb();
             }
         }
     };
@@ -0,0 +1,98 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_CHASELEVDEQUE_HPP
+#define DRAFT_VK_CHASELEVDEQUE_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace dvk::jobs {
+
+    // Fixed capacity work-stealing deque of pointers (Chase and Lev, with the C11 orderings of Lê et al.).
+    // Only the owning thread pushes and pops, at the bottom, any thread steals from the top.
+    // The capacity is fixed so that neither side ever allocates, a full deque makes push fail.
+    template<typename T, int64_t Capacity>
+    class ChaseLevDeque {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    private:
+        // Top and bottom on their own cache lines, thieves hammer top while the owner moves bottom
+        alignas(64) std::atomic<int64_t> top{0};
+        alignas(64) std::atomic<int64_t> bottom{0};
+        alignas(64) std::atomic<T*> items[Capacity]{};
+    public:
+        // Owner only
+        bool push(T* item)
+        {
+            int64_t b = bottom.load(std::memory_order_relaxed);
+            int64_t t = top.load(std::memory_order_acquire);
+            if (b - t >= Capacity)
+            {
+                return false;
+            }
+
+            items[b & (Capacity - 1)].store(item, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // Owner only, takes the most recently pushed item
+        T* pop()
+        {
+            int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = top.load(std::memory_order_relaxed);
+
+            if (t > b)
+            {
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T* item = items[b & (Capacity - 1)].load(std::memory_order_relaxed);
+            if (t == b)
+            {
+                // Last item, race the thieves for it
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    item = nullptr;
+                }
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return item;
+        }
+
+        // Any thread, takes the oldest item. Returns nullptr when empty or when another thread won the race.
+        T* steal()
+        {
+            int64_t t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t b = bottom.load(std::memory_order_acquire);
+
+            if (t >= b)
+            {
+                return nullptr;
+            }
+
+            T* item = items[t & (Capacity - 1)].load(std::memory_order_relaxed);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+            return item;
+        }
+
+        // A snapshot, only a hint when other threads are active
+        [[nodiscard]]
+        bool empty() const
+        {
+            return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+        }
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_CHASELEVDEQUE_HPP
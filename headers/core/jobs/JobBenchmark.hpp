@@ -0,0 +1,21 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_JOBBENCHMARK_HPP
+#define DRAFT_VK_JOBBENCHMARK_HPP
+
+#include <cstdint>
+#include <ostream>
+
+namespace dvk::jobs {
+
+    constexpr uint32_t DEFAULT_BENCHMARK_JOBS = 1 << 16;
+
+    // Scheduling overhead of the job system: nanoseconds per empty job for batches of run(), for parallelFor at
+    // a grain of 1 and 64, against a plain indirect call. Writes a JSON report, the best of a few repetitions.
+    void runJobBenchmark(uint32_t threadCount, uint32_t jobCount, std::ostream& out);
+
+} // dvk
+
+#endif //DRAFT_VK_JOBBENCHMARK_HPP
@@ -0,0 +1,104 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_JOBSYSTEM_HPP
+#define DRAFT_VK_JOBSYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ChaseLevDeque.hpp"
+#include "ParallelExecutor.hpp"
+
+namespace dvk::jobs {
+
+    using JobFunction = void (*)(void* context, uint32_t begin, uint32_t end);
+
+    // Jobs still to finish, wait on it once every job referencing it is submitted
+    struct JobCounter {
+        std::atomic<uint32_t> value{0};
+    };
+
+    struct Job {
+        JobFunction function = nullptr;
+        void* context = nullptr;
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        JobCounter* counter = nullptr;
+        // Set by the submitting worker, cleared by whichever worker runs the job
+        std::atomic<bool> inUse{false};
+    };
+
+    // Jobs each worker can have in flight, a worker past it runs its next jobs inline
+    constexpr uint32_t MAX_JOBS_PER_WORKER = 4096;
+
+    // The renderer's thread pool. Every worker owns a Chase-Lev deque and a fixed ring of jobs: it pushes and pops
+    // its own jobs LIFO, idle workers steal FIFO from the others, then sleep until jobs are pushed again.
+    // The thread that constructs or last attached to the system is worker 0, it runs jobs while it waits on a counter.
+    // Only worker threads can submit, nothing allocates once the system is constructed.
+    class JobSystem : public ParallelExecutor {
+    private:
+        struct Worker {
+            ChaseLevDeque<Job, MAX_JOBS_PER_WORKER> deque;
+            std::unique_ptr<Job[]> jobs;
+            uint32_t nextJob = 0;
+            std::thread thread;
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::atomic<bool> stopping{false};
+        // Pushed jobs not yet taken, sleeping workers wake up when it is positive
+        std::atomic<int64_t> pendingJobs{0};
+        std::atomic<uint32_t> sleepingWorkers{0};
+        std::mutex sleepMutex;
+        std::condition_variable wakeCondition;
+        JobSystem* previousSystem;
+        uint32_t previousWorker;
+
+        uint32_t getWorkerIndex() const;
+        Job* allocateJob(Worker& worker);
+        Job* findJob(uint32_t workerIndex);
+        void execute(Job* job);
+        void workerLoop(uint32_t workerIndex);
+    public:
+        // 0 threads uses one per hardware thread, the calling thread included
+        explicit JobSystem(uint32_t threadCount = 0);
+        ~JobSystem() override;
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // Makes the calling thread worker 0, e.g. a render thread, the thread it replaces must stop submitting
+        void attachThread();
+
+        // Runs function(context, begin, end) on some worker, counter (if any) drops by one once it returns
+        void run(JobFunction function, void* context, uint32_t begin, uint32_t end, JobCounter* counter);
+        // Runs other jobs until the counter reaches zero
+        void wait(JobCounter& counter);
+        // Runs one of the calling worker's jobs or one stolen from another, false when there was none
+        bool tryRunJob();
+        // Splits [0, count) into ranges of at most grain items, runs them and waits for all of them
+        void parallelForRanges(uint32_t count, uint32_t grain, JobFunction function, void* context);
+
+        // body(begin, end) over ranges of at most grain items, the body must be safe to call concurrently
+        template<typename F>
+        void parallelFor(uint32_t count, uint32_t grain, F& body)
+        {
+            parallelForRanges(count, grain, [](void* context, uint32_t begin, uint32_t end) {
+                (*static_cast<F*>(context))(begin, end);
+            }, &body);
+        }
+
+        [[nodiscard]]
+        uint32_t getConcurrency() const override;
+        void parallelFor(uint32_t taskCount, TaskFunction task) override;
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_JOBSYSTEM_HPP
@@ -0,0 +1,47 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_PARALLELEXECUTOR_HPP
+#define DRAFT_VK_PARALLELEXECUTOR_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+namespace dvk {
+
+    // Non-owning reference to a callable taking a task index. Unlike std::function it never allocates,
+    // the callable must outlive the call it is passed to.
+    class TaskFunction {
+    private:
+        void* object;
+        void (*invoke)(void*, uint32_t);
+    public:
+        template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, TaskFunction>>>
+        TaskFunction(F& function) :
+            object(&function),
+            invoke([](void* callable, uint32_t task) { (*static_cast<F*>(callable))(task); })
+        {
+
+        }
+
+        void operator()(uint32_t task) const {
+            invoke(object, task);
+        }
+    };
+
+    // Something that can run independent tasks concurrently, e.g. a job system
+    class ParallelExecutor {
+    public:
+        virtual ~ParallelExecutor() = default;
+
+        // Threads that can run tasks at once, the calling one included
+        [[nodiscard]]
+        virtual uint32_t getConcurrency() const = 0;
+        // Runs task(0) to task(taskCount - 1) and returns once all of them are done
+        virtual void parallelFor(uint32_t taskCount, TaskFunction task) = 0;
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_PARALLELEXECUTOR_HPP
@@ -0,0 +1,23 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_ALLOCATIONCOUNTER_HPP
+#define DRAFT_VK_ALLOCATIONCOUNTER_HPP
+
+#include <cstdint>
+
+namespace dvk::memory {
+
+    // Configure with -DDVK_ALLOCATION_HOOK=ON to replace the global operator new with one that counts calls.
+    // Only threads that opted in are counted, the render thread and the job workers: background threads such as the
+    // debug message drain or the driver's are not part of a frame. Allocations made through malloc are not seen.
+    bool isAllocationCountingEnabled();
+    // Counts the calling thread's allocations from now on
+    void countThreadAllocations();
+    // Sum over the counted threads
+    uint64_t getAllocationCount();
+
+} // dvk
+
+#endif //DRAFT_VK_ALLOCATIONCOUNTER_HPP
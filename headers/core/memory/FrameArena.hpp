@@ -0,0 +1,122 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_FRAMEARENA_HPP
+#define DRAFT_VK_FRAMEARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace dvk::memory {
+
+    constexpr size_t DEFAULT_FRAME_ARENA_SIZE = 1024 * 1024;
+
+    // Bump allocator over a fixed block, nothing is freed individually and nothing is destroyed on reset
+    class LinearArena {
+    private:
+        std::unique_ptr<std::byte[]> memory;
+        size_t capacity;
+        size_t offset = 0;
+        size_t highWater = 0;
+    public:
+        explicit LinearArena(size_t capacity);
+
+        void* allocate(size_t size, size_t alignment) {
+            // The address is aligned, the block itself is only aligned for new
+            auto base = reinterpret_cast<uintptr_t>(memory.get());
+            size_t begin = ((base + offset + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+            if (begin + size > capacity)
+            {
+                throw std::runtime_error("Linear arena exhausted!");
+            }
+            offset = begin + size;
+            return memory.get() + begin;
+        }
+
+        template<typename T>
+        T* allocateArray(size_t count) {
+            static_assert(std::is_trivially_destructible_v<T>, "Arena memory is never destroyed");
+            return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        void reset();
+
+        [[nodiscard]]
+        size_t getUsed() const;
+        [[nodiscard]]
+        size_t getCapacity() const;
+        [[nodiscard]]
+        size_t getHighWater() const;
+    };
+
+    // STL allocator over a LinearArena. Deallocation is a no-op, a container using it must not outlive the arena's reset.
+    template<typename T>
+    class ArenaAllocator {
+    private:
+        template<typename U>
+        friend class ArenaAllocator;
+
+        LinearArena* arena;
+    public:
+        using value_type = T;
+
+        explicit ArenaAllocator(LinearArena* arena) noexcept : arena(arena) {}
+
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+        T* allocate(size_t count) {
+            return static_cast<T*>(arena->allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        void deallocate(T*, size_t) noexcept {}
+
+        template<typename U>
+        bool operator==(const ArenaAllocator<U>& other) const noexcept {
+            return arena == other.arena;
+        }
+
+        template<typename U>
+        bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+            return arena != other.arena;
+        }
+    };
+
+    template<typename T>
+    using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+    // Arenas for data that only lives until a frame's GPU work is done. Each frame in flight gets one arena per
+    // thread recording for it, so threads never share a bump pointer.
+    // Frames are retired either by their fence (beginFrame) or by a timeline semaphore value (retire).
+    class FrameArenas {
+    private:
+        const uint32_t framesInFlight;
+        const uint32_t threadCount;
+        std::vector<LinearArena> arenas;
+        // Timeline value signaled once the frame's GPU work is done, 0 when there is nothing to retire
+        std::vector<uint64_t> retireValues;
+
+        void resetFrame(uint32_t frame);
+    public:
+        FrameArenas(uint32_t framesInFlight, uint32_t threadCount, size_t capacityPerThread);
+
+        // The frame's fence must have been waited on, everything allocated for its previous use is dropped
+        LinearArena& beginFrame(uint32_t frame);
+        LinearArena& getArena(uint32_t frame, uint32_t thread = 0);
+
+        void setRetireValue(uint32_t frame, uint64_t timelineValue);
+        // Resets every frame whose timeline value has been reached
+        void retire(uint64_t completedTimelineValue);
+
+        [[nodiscard]]
+        uint32_t getThreadCount() const;
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_FRAMEARENA_HPP
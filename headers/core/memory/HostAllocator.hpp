@@ -0,0 +1,82 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_HOSTALLOCATOR_HPP
+#define DRAFT_VK_HOSTALLOCATOR_HPP
+
+#include <vulkan/vulkan_core.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace dvk::memory {
+
+    constexpr uint32_t HOST_ALLOCATION_SCOPE_COUNT = VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1;
+
+    const char* getAllocationScopeName(VkSystemAllocationScope scope);
+
+    struct HostScopeStats {
+        uint64_t allocations = 0;
+        uint64_t frees = 0;
+        uint64_t arenaAllocations = 0;
+        uint64_t liveAllocations = 0;
+        uint64_t liveBytes = 0;
+        uint64_t peakBytes = 0;
+        uint64_t internalBytes = 0;
+    };
+
+    // VkAllocationCallbacks that count allocations and bytes per VkSystemAllocationScope.
+    // Command scope allocations only live for the duration of one Vulkan command, they are bumped out of a
+    // thread-local arena that rewinds once all of them are freed. Other scopes go to the heap.
+    class HostAllocator {
+    private:
+        struct ScopeCounters {
+            std::atomic<uint64_t> allocations{0};
+            std::atomic<uint64_t> frees{0};
+            std::atomic<uint64_t> arenaAllocations{0};
+            std::atomic<uint64_t> liveAllocations{0};
+            std::atomic<uint64_t> liveBytes{0};
+            std::atomic<uint64_t> peakBytes{0};
+            std::atomic<uint64_t> internalBytes{0};
+        };
+
+        VkAllocationCallbacks callbacks{};
+        ScopeCounters scopes[HOST_ALLOCATION_SCOPE_COUNT];
+
+        void* allocate(size_t size, size_t alignment, VkSystemAllocationScope scope);
+        void* reallocate(void* original, size_t size, size_t alignment, VkSystemAllocationScope scope);
+        void free(void* memory);
+        void onAllocation(uint32_t scope, size_t size, bool fromArena);
+        void onFree(uint32_t scope, size_t size);
+
+        static void* VKAPI_CALL allocationCallback(void* userData, size_t size, size_t alignment, VkSystemAllocationScope scope);
+        static void* VKAPI_CALL reallocationCallback(void* userData, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope);
+        static void VKAPI_CALL freeCallback(void* userData, void* memory);
+        static void VKAPI_CALL internalAllocationCallback(void* userData, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope);
+        static void VKAPI_CALL internalFreeCallback(void* userData, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope);
+    public:
+        HostAllocator();
+
+        HostAllocator(const HostAllocator&) = delete;
+        HostAllocator& operator=(const HostAllocator&) = delete;
+
+        const VkAllocationCallbacks* getCallbacks() const;
+        HostScopeStats getStats(VkSystemAllocationScope scope) const;
+        bool hasLeaks() const;
+
+        // Per scope counters, followed by the allocations still alive, meant to be called once every object is destroyed
+        void writeReport(std::ostream& out) const;
+    };
+
+    HostAllocator& getHostAllocator();
+
+    // Callbacks passed as pAllocator to every vkCreate* / vkDestroy* call, the tracking allocator by default.
+    // Replace them before the instance is created, an object must be destroyed with the callbacks it was created with.
+    const VkAllocationCallbacks* getAllocationCallbacks();
+    void setAllocationCallbacks(const VkAllocationCallbacks* callbacks);
+
+} // dvk
+
+#endif //DRAFT_VK_HOSTALLOCATOR_HPP
@@ -0,0 +1,158 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_APICALLCOUNTER_HPP
+#define DRAFT_VK_APICALLCOUNTER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Device entry points the renderer calls, all through the DeviceDispatch table: X(name, timed).
+// Timed ones are the calls that may block or compile, their duration is measured on top of the count.
+#define DVK_DEVICE_ENTRY_POINTS(X) \
+    X(vkAcquireNextImageKHR, true) \
+    X(vkQueuePresentKHR, true) \
+    X(vkQueueSubmit, true) \
+    X(vkCreateGraphicsPipelines, true) \
+    X(vkCreateComputePipelines, true) \
+    X(vkQueueWaitIdle, true) \
+    X(vkDeviceWaitIdle, true) \
+    X(vkWaitForFences, false) \
+    X(vkResetFences, false) \
+    X(vkResetCommandBuffer, false) \
+    X(vkBeginCommandBuffer, false) \
+    X(vkEndCommandBuffer, false) \
+    X(vkResetQueryPool, false) \
+    X(vkGetQueryPoolResults, false) \
+    X(vkInvalidateMappedMemoryRanges, false) \
+    X(vkUpdateDescriptorSets, false) \
+    X(vkCmdBeginRenderPass, false) \
+    X(vkCmdEndRenderPass, false) \
+    X(vkCmdSetViewport, false) \
+    X(vkCmdSetScissor, false) \
+    X(vkCmdBindPipeline, false) \
+    X(vkCmdBindVertexBuffers, false) \
+    X(vkCmdBindDescriptorSets, false) \
+    X(vkCmdPushConstants, false) \
+    X(vkCmdDraw, false) \
+    X(vkCmdDrawIndirectCount, false) \
+    X(vkCmdDispatch, false) \
+    X(vkCmdPipelineBarrier, false) \
+    X(vkCmdBlitImage, false) \
+    X(vkCmdFillBuffer, false) \
+    X(vkCmdCopyBuffer, false) \
+    X(vkCmdCopyImageToBuffer, false) \
+    X(vkCmdResetQueryPool, false) \
+    X(vkCmdWriteTimestamp, false) \
+    X(vkGetDeviceQueue, false) \
+    X(vkDestroyDevice, false) \
+    X(vkCreateSwapchainKHR, false) \
+    X(vkDestroySwapchainKHR, false) \
+    X(vkGetSwapchainImagesKHR, false) \
+    X(vkAllocateMemory, false) \
+    X(vkFreeMemory, false) \
+    X(vkMapMemory, false) \
+    X(vkUnmapMemory, false) \
+    X(vkCreateBuffer, false) \
+    X(vkDestroyBuffer, false) \
+    X(vkGetBufferMemoryRequirements, false) \
+    X(vkBindBufferMemory, false) \
+    X(vkCreateImage, false) \
+    X(vkDestroyImage, false) \
+    X(vkGetImageMemoryRequirements, false) \
+    X(vkBindImageMemory, false) \
+    X(vkCreateImageView, false) \
+    X(vkDestroyImageView, false) \
+    X(vkCreateFramebuffer, false) \
+    X(vkDestroyFramebuffer, false) \
+    X(vkCreateRenderPass, false) \
+    X(vkDestroyRenderPass, false) \
+    X(vkCreateShaderModule, false) \
+    X(vkDestroyShaderModule, false) \
+    X(vkCreatePipelineLayout, false) \
+    X(vkDestroyPipelineLayout, false) \
+    X(vkDestroyPipeline, false) \
+    X(vkCreateDescriptorSetLayout, false) \
+    X(vkDestroyDescriptorSetLayout, false) \
+    X(vkCreateDescriptorPool, false) \
+    X(vkDestroyDescriptorPool, false) \
+    X(vkAllocateDescriptorSets, false) \
+    X(vkCreateCommandPool, false) \
+    X(vkDestroyCommandPool, false) \
+    X(vkAllocateCommandBuffers, false) \
+    X(vkCreateFence, false) \
+    X(vkDestroyFence, false) \
+    X(vkCreateSemaphore, false) \
+    X(vkDestroySemaphore, false) \
+    X(vkCreateQueryPool, false) \
+    X(vkDestroyQueryPool, false)
+
+namespace dvk {
+
+    enum class ApiCall : uint32_t {
+#define DVK_API_CALL_ENUM(name, timed) name,
+        DVK_DEVICE_ENTRY_POINTS(DVK_API_CALL_ENUM)
+#undef DVK_API_CALL_ENUM
+        Count
+    };
+
+    constexpr size_t API_CALL_COUNT = static_cast<size_t>(ApiCall::Count);
+
+    const char* getApiCallName(ApiCall call);
+
+    constexpr bool isApiCallTimed(ApiCall call)
+    {
+        switch (call) {
+#define DVK_API_CALL_TIMED(name, timed) case ApiCall::name: return timed;
+            DVK_DEVICE_ENTRY_POINTS(DVK_API_CALL_TIMED)
+#undef DVK_API_CALL_TIMED
+            default:
+                return false;
+        }
+    }
+
+    // Calls of each entry point made during one frame, and the time spent in the timed ones in milliseconds
+    struct ApiFrameCalls {
+        bool valid = false;
+        uint32_t calls[API_CALL_COUNT]{};
+        double milliseconds[API_CALL_COUNT]{};
+    };
+
+    // Fed by the counting wrappers of the DeviceDispatch table, from any thread. A frame is whatever was called
+    // since the previous endFrame(), calls made between two frames (e.g. a swapchain recreation) go to the next one.
+    class ApiCallCounter {
+    private:
+        bool enabled = false;
+        std::atomic<uint64_t> calls[API_CALL_COUNT]{};
+        std::atomic<uint64_t> nanoseconds[API_CALL_COUNT]{};
+    public:
+        ApiCallCounter() = default;
+
+        ApiCallCounter(const ApiCallCounter&) = delete;
+        ApiCallCounter& operator=(const ApiCallCounter&) = delete;
+
+        // Before the device is created, the dispatch table only installs the wrappers when enabled
+        void setEnabled(bool enabled);
+        [[nodiscard]]
+        bool isEnabled() const;
+
+        void count(ApiCall call) {
+            calls[static_cast<size_t>(call)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void record(ApiCall call, uint64_t elapsedNanoseconds) {
+            calls[static_cast<size_t>(call)].fetch_add(1, std::memory_order_relaxed);
+            nanoseconds[static_cast<size_t>(call)].fetch_add(elapsedNanoseconds, std::memory_order_relaxed);
+        }
+
+        // Takes the counts since the previous call and starts the next frame, called once after startup as well
+        void endFrame(ApiFrameCalls& frame);
+    };
+
+    ApiCallCounter& getApiCallCounter();
+
+} // dvk
+
+#endif //DRAFT_VK_APICALLCOUNTER_HPP
@@ -0,0 +1,76 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_BENCHMARK_HPP
+#define DRAFT_VK_BENCHMARK_HPP
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include "FrameTimings.hpp"
+
+namespace dvk {
+
+    enum class ReportFormat {
+        Json,
+        Csv
+    };
+
+    struct SampleSummary {
+        size_t count = 0;
+        double min = 0.0;
+        double mean = 0.0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    // Runs a fixed number of warm-up frames, then records the timings of a fixed number of measured frames.
+    // Samples are stored in memory reserved up front so measuring does not disturb the frames being measured.
+    class Benchmark {
+    private:
+        struct ReportRow {
+            std::string name;
+            SampleSummary summary;
+        };
+
+        const uint32_t warmupFrames;
+        const uint32_t measuredFrames;
+        const bool paced;
+        uint32_t recordedFrames = 0;
+        std::vector<FrameTimings> samples;
+        ApiFrameCalls startupApiCalls{};
+
+        static SampleSummary summarize(std::vector<double>& values);
+        std::vector<ReportRow> buildCpuRows() const;
+        std::vector<ReportRow> buildGpuRows() const;
+        std::vector<ReportRow> buildApiCallRows() const;
+        std::vector<ReportRow> buildApiTimeRows() const;
+        std::vector<ReportRow> buildStartupApiRows(bool time) const;
+        [[nodiscard]]
+        bool hasApiCalls() const;
+        size_t countFrames(FrameBound bound) const;
+        static void writeJsonRows(std::ostream& out, const char* key, const std::vector<ReportRow>& rows);
+        void writeJson(std::ostream& out) const;
+        void writeCsv(std::ostream& out) const;
+    public:
+        // Frames are only reported with a pacing error when a frame pacer is in use
+        Benchmark(uint32_t warmupFrames, uint32_t measuredFrames, bool paced);
+
+        void recordFrame(const FrameTimings& timings);
+        // Calls made while building the renderer, reported next to the per-frame ones
+        void setStartupApiCalls(const ApiFrameCalls& calls);
+        [[nodiscard]]
+        bool isComplete() const;
+        [[nodiscard]]
+        uint32_t getTotalFrames() const;
+
+        void writeReport(std::ostream& out, ReportFormat format) const;
+        static ReportFormat parseReportFormat(const std::string& format);
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_BENCHMARK_HPP
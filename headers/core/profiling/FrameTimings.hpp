@@ -0,0 +1,67 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_FRAMETIMINGS_HPP
+#define DRAFT_VK_FRAMETIMINGS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include "ApiCallCounter.hpp"
+
+namespace dvk {
+
+    enum class FramePhase : uint32_t {
+        Wait,
+        Pace,
+        Acquire,
+        Record,
+        Submit,
+        Present,
+        Count
+    };
+
+    constexpr size_t FRAME_PHASE_COUNT = static_cast<size_t>(FramePhase::Count);
+    constexpr size_t MAX_GPU_SCOPES = 8;
+
+    enum class FrameBound {
+        Unknown,
+        Cpu,
+        Gpu
+    };
+
+    const char* getFramePhaseName(FramePhase phase);
+
+    // GPU time of the named scopes of one frame, in milliseconds
+    struct GpuFrameTimings {
+        bool valid = false;
+        uint32_t scopeCount = 0;
+        const char* scopeNames[MAX_GPU_SCOPES]{};
+        double scopes[MAX_GPU_SCOPES]{};
+        double total = 0.0;
+    };
+
+    // CPU time spent in each phase of Core::drawFrame, in milliseconds.
+    // GPU timings come back a few frames late, so they belong to the frame that retired at the start of this one.
+    struct FrameTimings {
+        double phases[FRAME_PHASE_COUNT]{};
+        double total = 0.0;
+        // How late the frame pacer let the frame start, 0 without a target rate
+        double pacingError = 0.0;
+        GpuFrameTimings gpu{};
+        // Only with the API call counter enabled
+        ApiFrameCalls api{};
+        FrameBound bound = FrameBound::Unknown;
+
+        double& operator[](FramePhase phase) {
+            return phases[static_cast<size_t>(phase)];
+        }
+
+        double operator[](FramePhase phase) const {
+            return phases[static_cast<size_t>(phase)];
+        }
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_FRAMETIMINGS_HPP
@@ -0,0 +1,64 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_GPUPROFILER_HPP
+#define DRAFT_VK_GPUPROFILER_HPP
+
+#include <vulkan/vulkan_core.h>
+#include <vector>
+#include "FrameTimings.hpp"
+#include "DeviceProfile.hpp"
+
+namespace dvk {
+
+    // Timestamp queries around named scopes of a command buffer.
+    // Each frame in flight owns a slice of the query pool, its results are read once the frame's fence
+    // has been waited on, so reading never stalls.
+    class GpuProfiler {
+    private:
+        struct FrameQueries {
+            bool pending = false;
+            uint32_t scopeCount = 0;
+            const char* scopeNames[MAX_GPU_SCOPES]{};
+            // Trace clock time of the submit, anchors the scopes on the CPU timeline
+            uint64_t submitTime = 0;
+        };
+
+        const DeviceProfile* deviceProfile;
+        VkDevice* device;
+        VkQueryPool queryPool{};
+        const uint32_t framesInFlight;
+        bool supported = false;
+        // Queries are reset on the host once read instead of in the next frame's command buffer
+        bool hostQueryReset = false;
+        double timestampPeriod = 0.0;
+        uint64_t timestampMask = 0;
+        std::vector<FrameQueries> frames;
+        std::vector<uint64_t> results;
+        uint64_t lastTraceEnd = 0;
+
+        void createQueryPool(uint32_t queueFamilyIndex);
+        void writeTraceEvents(const FrameQueries& queries, uint64_t frameBegin);
+        [[nodiscard]]
+        uint32_t getFirstQuery(uint32_t frame) const;
+    public:
+        GpuProfiler(const DeviceProfile* deviceProfile, VkDevice* device, uint32_t queueFamilyIndex, uint32_t framesInFlight);
+        ~GpuProfiler();
+
+        // Must be recorded outside of a render pass, before any scope of the frame
+        void beginFrame(VkCommandBuffer commandBuffer, uint32_t frame);
+        uint32_t beginScope(VkCommandBuffer commandBuffer, uint32_t frame, const char* name);
+        void endScope(VkCommandBuffer commandBuffer, uint32_t frame, uint32_t scope);
+        void markSubmitted(uint32_t frame);
+
+        // Reads back the scopes last recorded for this frame slot, its fence must already be signaled
+        bool collect(uint32_t frame, GpuFrameTimings& timings);
+
+        [[nodiscard]]
+        bool isSupported() const;
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_GPUPROFILER_HPP
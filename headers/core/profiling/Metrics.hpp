@@ -0,0 +1,147 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_METRICS_HPP
+#define DRAFT_VK_METRICS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace dvk::metrics {
+
+    class Metric {
+    protected:
+        const std::string name;
+        const std::string help;
+    public:
+        Metric(std::string name, std::string help);
+        virtual ~Metric() = default;
+
+        virtual void writePrometheus(std::ostream& out) const = 0;
+    };
+
+    // Updates are single relaxed atomics, any thread may update while an export is running
+    class Counter : public Metric {
+    private:
+        std::atomic<uint64_t> value{0};
+    public:
+        using Metric::Metric;
+
+        void add(uint64_t amount = 1) {
+            value.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]]
+        uint64_t getValue() const {
+            return value.load(std::memory_order_relaxed);
+        }
+
+        void writePrometheus(std::ostream& out) const override;
+    };
+
+    class Gauge : public Metric {
+    private:
+        std::atomic<double> value{0.0};
+    public:
+        using Metric::Metric;
+
+        void set(double newValue) {
+            value.store(newValue, std::memory_order_relaxed);
+        }
+
+        void add(double amount) {
+            value.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]]
+        double getValue() const {
+            return value.load(std::memory_order_relaxed);
+        }
+
+        void writePrometheus(std::ostream& out) const override;
+    };
+
+    // Buckets are fixed at creation, an observation lands in the first bucket whose upper bound holds it
+    class Histogram : public Metric {
+    private:
+        const std::vector<double> upperBounds;
+        // One more than the bounds, the last one is +Inf
+        std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+        std::atomic<double> sum{0.0};
+        std::atomic<uint64_t> count{0};
+    public:
+        Histogram(std::string name, std::string help, std::vector<double> upperBounds);
+
+        void observe(double value) {
+            size_t bucket = 0;
+            while (bucket < upperBounds.size() && value > upperBounds[bucket])
+            {
+                bucket++;
+            }
+            buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+            sum.fetch_add(value, std::memory_order_relaxed);
+            count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void writePrometheus(std::ostream& out) const override;
+
+        static std::vector<double> exponentialBounds(double start, double factor, uint32_t count);
+    };
+
+    // Owns the metrics and keeps them in registration order. Registration locks, updates never do.
+    class Registry {
+    private:
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Metric>> metrics;
+    public:
+        Counter& addCounter(std::string name, std::string help);
+        Gauge& addGauge(std::string name, std::string help);
+        Histogram& addHistogram(std::string name, std::string help, std::vector<double> upperBounds);
+
+        void writePrometheus(std::ostream& out);
+        // Written to a temporary file then renamed, so a textfile collector never reads a partial snapshot
+        void writePrometheusFile(const std::string& fileName);
+    };
+
+    // Metrics updated by the renderer itself
+    struct RendererMetrics {
+        Counter& frames;
+        Counter& drawCalls;
+        Histogram& drawsPerFrame;
+        Counter& triangles;
+        Counter& pipelineBinds;
+        Counter& skippedBinds;
+        Counter& uploadedBytes;
+        Counter& queueSubmits;
+        Counter& deviceAllocations;
+        Gauge& liveDeviceAllocations;
+        Counter& swapchainRecreations;
+        Histogram& swapchainRecreationSeconds;
+        Histogram& fenceWaitSeconds;
+        Histogram& pacingErrorSeconds;
+        Gauge& resolutionScale;
+
+        explicit RendererMetrics(Registry& registry);
+
+        void onDeviceAllocation() {
+            deviceAllocations.add();
+            liveDeviceAllocations.add(1.0);
+        }
+
+        void onDeviceFree() {
+            liveDeviceAllocations.add(-1.0);
+        }
+    };
+
+    Registry& getRegistry();
+    RendererMetrics& getRendererMetrics();
+
+} // dvk
+
+#endif //DRAFT_VK_METRICS_HPP
@@ -0,0 +1,43 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_METRICSEXPORTER_HPP
+#define DRAFT_VK_METRICSEXPORTER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Metrics.hpp"
+
+namespace dvk::metrics {
+
+    // Writes the registry to a file periodically from its own thread, so that the file write and rename never land
+    // on the render thread. Updates are atomics, the snapshot is taken while the renderer keeps running.
+    class MetricsExporter {
+    private:
+        Registry& registry;
+        const std::string fileName;
+        const std::chrono::steady_clock::duration period;
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool stopping = false;
+        std::thread exportThread;
+
+        void exportLoop();
+    public:
+        MetricsExporter(Registry& registry, std::string fileName, std::chrono::steady_clock::duration period);
+        ~MetricsExporter();
+
+        MetricsExporter(const MetricsExporter&) = delete;
+        MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+        // Joins the thread, the caller writes the final export
+        void stop();
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_METRICSEXPORTER_HPP
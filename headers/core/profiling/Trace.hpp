@@ -0,0 +1,101 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_TRACE_HPP
+#define DRAFT_VK_TRACE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Scoped CPU trace zones. Each thread writes into its own ring buffer, a zone costs two clock reads and a handful of
+// relaxed stores. Configure with -DDVK_TRACING=ON to enable them, otherwise the macros compile to nothing.
+#ifdef DVK_ENABLE_TRACING
+    #define DVK_TRACE_CONCAT_IMPL(a, b) a##b
+    #define DVK_TRACE_CONCAT(a, b) DVK_TRACE_CONCAT_IMPL(a, b)
+    #define DVK_TRACE_ZONE(name) ::dvk::trace::Zone DVK_TRACE_CONCAT(dvkTraceZone, __LINE__)(name)
+    #define DVK_TRACE_THREAD_NAME(name) ::dvk::trace::setThreadName(name)
+#else
+    #define DVK_TRACE_ZONE(name) ((void)0)
+    #define DVK_TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+namespace dvk::trace {
+
+    // Zone names must be string literals or otherwise outlive the trace
+    struct Event {
+        const char* name;
+        uint64_t begin;
+        uint64_t end;
+    };
+
+    // Single producer ring, only the owning thread writes. Each slot is a seqlock: the exporter can read the ring while
+    // its thread keeps writing, and drops the slots that were overwritten while it copied them.
+    class ThreadBuffer {
+    private:
+        static constexpr uint64_t CAPACITY = 1 << 16;
+
+        struct Slot {
+            // 2 * index + 1 while the event of that index is written, 2 * index + 2 once it is complete
+            std::atomic<uint64_t> sequence{0};
+            std::atomic<const char*> name{nullptr};
+            std::atomic<uint64_t> begin{0};
+            std::atomic<uint64_t> end{0};
+        };
+
+        Slot slots[CAPACITY];
+        std::atomic<uint64_t> writeIndex{0};
+        std::string threadName;
+        const uint32_t threadId;
+
+        bool tryRead(uint64_t index, Event& event) const;
+    public:
+        ThreadBuffer(uint32_t threadId, std::string threadName);
+
+        void write(const char* name, uint64_t begin, uint64_t end) {
+            uint64_t index = writeIndex.load(std::memory_order_relaxed);
+            Slot& slot = slots[index & (CAPACITY - 1)];
+            slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.name.store(name, std::memory_order_relaxed);
+            slot.begin.store(begin, std::memory_order_relaxed);
+            slot.end.store(end, std::memory_order_relaxed);
+            slot.sequence.store(2 * index + 2, std::memory_order_release);
+            writeIndex.store(index + 1, std::memory_order_release);
+        }
+
+        void setThreadName(std::string name);
+        void writeChromeEvents(std::ostream& out, bool& first) const;
+    };
+
+    // Nanoseconds since the trace clock started
+    uint64_t now();
+    bool isEnabled();
+    ThreadBuffer& getThreadBuffer();
+    void setThreadName(const char* name);
+
+    // Events recorded on behalf of the GPU, e.g. timestamp query results, land on their own track
+    void writeGpuEvent(const char* name, uint64_t begin, uint64_t end);
+
+    void writeChromeTrace(std::ostream& out);
+    void writeChromeTrace(const std::string& fileName);
+
+    class Zone {
+    private:
+        const char* name;
+        uint64_t begin;
+    public:
+        explicit Zone(const char* name) : name(name), begin(now()) {}
+        ~Zone() {
+            getThreadBuffer().write(name, begin, now());
+        }
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_TRACE_HPP
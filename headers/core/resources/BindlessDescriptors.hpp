@@ -0,0 +1,97 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_BINDLESSDESCRIPTORS_HPP
+#define DRAFT_VK_BINDLESSDESCRIPTORS_HPP
+
+#include <vulkan/vulkan_core.h>
+#include <array>
+#include <vector>
+
+namespace dvk {
+
+    // Requested array sizes, lowered to the device's update-after-bind limits
+    constexpr uint32_t DEFAULT_BINDLESS_SAMPLED_IMAGES = 16384;
+    constexpr uint32_t DEFAULT_BINDLESS_STORAGE_BUFFERS = 4096;
+    constexpr uint32_t DEFAULT_BINDLESS_SAMPLERS = 64;
+
+    // Bindings of the bindless set, also the array each slot indexes into
+    enum class BindlessType : uint32_t {
+        SampledImage = 0,
+        StorageBuffer = 1,
+        Sampler = 2
+    };
+
+    // Push constants of every pipeline using the bindless layout, slots in the bindless arrays
+    struct BindlessIndices {
+        uint32_t storageBuffer = 0;
+        uint32_t sampledImage = 0;
+        uint32_t sampler = 0;
+        uint32_t userData = 0;
+    };
+
+    // One descriptor set holding every sampled image, storage buffer and sampler of the renderer in partially bound,
+    // update-after-bind arrays, bound once per frame. Resources get a slot from a free list and shaders index the
+    // arrays with the slots passed as push constants, so draws never bind descriptors.
+    class BindlessDescriptors {
+    private:
+        struct SlotAllocator {
+            uint32_t capacity = 0;
+            // Slots never handed out start here
+            uint32_t next = 0;
+            std::vector<uint32_t> freeSlots;
+            // Released slots with the frame they were released in, frames in flight may still read them
+            std::vector<std::pair<uint64_t, uint32_t>> retired;
+        };
+
+        VkPhysicalDevice* physicalDevice;
+        VkDevice* device;
+        const uint32_t framesInFlight;
+        uint64_t frameNumber = 0;
+        std::array<SlotAllocator, 3> slots;
+        VkDescriptorSetLayout descriptorSetLayout{};
+        VkDescriptorPool descriptorPool{};
+        VkDescriptorSet descriptorSet{};
+        // Set 0 and the push constants of every pipeline using the set, which keeps it bound across pipeline binds
+        VkPipelineLayout pipelineLayout{};
+
+        void clampCapacities();
+        void createDescriptorSetLayout();
+        void createDescriptorPool();
+        void allocateDescriptorSet();
+        void createPipelineLayout();
+        uint32_t allocateSlot(BindlessType type);
+    public:
+        BindlessDescriptors(
+                VkPhysicalDevice* physicalDevice,
+                VkDevice* device,
+                uint32_t framesInFlight,
+                uint32_t sampledImageCapacity,
+                uint32_t storageBufferCapacity,
+                uint32_t samplerCapacity
+                );
+        ~BindlessDescriptors();
+
+        uint32_t addSampledImage(VkImageView imageView, VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        uint32_t addStorageBuffer(VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+        uint32_t addSampler(VkSampler sampler);
+        // The slot is handed out again once the frames in flight that may read it have finished
+        void release(BindlessType type, uint32_t slot);
+        // Once per frame that will be submitted, after its fence wait and its image acquired
+        void beginFrame();
+
+        void bind(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint);
+        void pushIndices(VkCommandBuffer commandBuffer, const BindlessIndices& indices);
+
+        VkDescriptorSetLayout* getDescriptorSetLayout();
+        VkPipelineLayout* getPipelineLayout();
+        [[nodiscard]]
+        static VkPushConstantRange getPushConstantRange();
+        [[nodiscard]]
+        uint32_t getCapacity(BindlessType type) const;
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_BINDLESSDESCRIPTORS_HPP
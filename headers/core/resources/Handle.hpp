@@ -0,0 +1,65 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_HANDLE_HPP
+#define DRAFT_VK_HANDLE_HPP
+
+#include <cstdint>
+
+namespace dvk {
+
+    // 32-bit reference into a SlotMap: the slot index in the low bits, the slot's generation in the high bits.
+    // A slot's generation changes every time its resource is removed, so a handle kept past that is detected as stale.
+    // The tag only keeps handles of different pools from being mixed up.
+    template<typename Tag>
+    class Handle {
+    private:
+        uint32_t value = 0;
+    public:
+        static constexpr uint32_t INDEX_BITS = 20;
+        static constexpr uint32_t GENERATION_BITS = 32 - INDEX_BITS;
+        static constexpr uint32_t MAX_INDEX = (1u << INDEX_BITS) - 1;
+        static constexpr uint32_t MAX_GENERATION = (1u << GENERATION_BITS) - 1;
+
+        Handle() = default;
+
+        // Generation 0 is never handed out, the default handle is null
+        static Handle make(uint32_t index, uint32_t generation) {
+            Handle handle;
+            handle.value = (generation << INDEX_BITS) | index;
+            return handle;
+        }
+
+        [[nodiscard]]
+        uint32_t getIndex() const {
+            return value & MAX_INDEX;
+        }
+
+        [[nodiscard]]
+        uint32_t getGeneration() const {
+            return value >> INDEX_BITS;
+        }
+
+        [[nodiscard]]
+        bool isNull() const {
+            return value == 0;
+        }
+
+        [[nodiscard]]
+        uint32_t getValue() const {
+            return value;
+        }
+
+        bool operator==(const Handle& other) const {
+            return value == other.value;
+        }
+
+        bool operator!=(const Handle& other) const {
+            return value != other.value;
+        }
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_HANDLE_HPP
@@ -0,0 +1,60 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_RESOURCEPOOLS_HPP
+#define DRAFT_VK_RESOURCEPOOLS_HPP
+
+#include <vulkan/vulkan_core.h>
+#include "SlotMap.hpp"
+
+namespace dvk {
+
+    struct BufferResource {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize size = 0;
+    };
+
+    struct ImageResource {
+        VkImage image = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        VkExtent2D extent{};
+    };
+
+    struct PipelineResource {
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+    };
+
+    using BufferHandle = Handle<BufferResource>;
+    using ImageHandle = Handle<ImageResource>;
+    using PipelineHandle = Handle<PipelineResource>;
+
+    struct MeshResource {
+        BufferHandle vertexBuffer;
+        uint32_t vertexCount = 0;
+        uint32_t firstVertex = 0;
+    };
+
+    using MeshHandle = Handle<MeshResource>;
+
+    // Lookup tables from handles to the Vulkan objects behind them. The classes creating the objects keep owning
+    // them, they register them here and remove them when they destroy them, which makes outstanding handles stale.
+    class ResourcePools {
+    private:
+        SlotMap<BufferResource, BufferResource> buffers;
+        SlotMap<ImageResource, ImageResource> images;
+        SlotMap<PipelineResource, PipelineResource> pipelines;
+        SlotMap<MeshResource, MeshResource> meshes;
+    public:
+        SlotMap<BufferResource, BufferResource>* getBuffers();
+        SlotMap<ImageResource, ImageResource>* getImages();
+        SlotMap<PipelineResource, PipelineResource>* getPipelines();
+        SlotMap<MeshResource, MeshResource>* getMeshes();
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_RESOURCEPOOLS_HPP
@@ -0,0 +1,144 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_SLOTMAP_HPP
+#define DRAFT_VK_SLOTMAP_HPP
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Handle.hpp"
+
+namespace dvk {
+
+    // Values are kept packed in insertion order, with removal swapping the last one into the hole, so iterating
+    // walks one contiguous array. Handles go through a slot table that stays put while values move.
+    template<typename T, typename Tag>
+    class SlotMap {
+    private:
+        struct Slot {
+            uint32_t valueIndex = 0;
+            uint32_t generation = 1;
+        };
+
+        std::vector<T> values;
+        // Slot of each value, to fix up the slot table when a value is moved
+        std::vector<uint32_t> valueSlots;
+        std::vector<Slot> slots;
+        std::vector<uint32_t> freeSlots;
+
+        const Slot* findSlot(Handle<Tag> handle) const {
+            uint32_t index = handle.getIndex();
+            if (handle.isNull() || index >= slots.size() || slots[index].generation != handle.getGeneration())
+            {
+                return nullptr;
+            }
+            return &slots[index];
+        }
+    public:
+        using HandleType = Handle<Tag>;
+
+        HandleType insert(T value)
+        {
+            uint32_t slot;
+            if (!freeSlots.empty())
+            {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+            }
+            else
+            {
+                if (slots.size() > HandleType::MAX_INDEX)
+                {
+                    throw std::runtime_error("Slot map is full!");
+                }
+                slot = static_cast<uint32_t>(slots.size());
+                slots.emplace_back();
+            }
+
+            slots[slot].valueIndex = static_cast<uint32_t>(values.size());
+            values.push_back(std::move(value));
+            valueSlots.push_back(slot);
+            return HandleType::make(slot, slots[slot].generation);
+        }
+
+        bool remove(HandleType handle)
+        {
+            const Slot* found = findSlot(handle);
+            if (found == nullptr)
+            {
+                return false;
+            }
+
+            uint32_t slot = handle.getIndex();
+            uint32_t valueIndex = found->valueIndex;
+            uint32_t lastIndex = static_cast<uint32_t>(values.size()) - 1;
+            if (valueIndex != lastIndex)
+            {
+                values[valueIndex] = std::move(values[lastIndex]);
+                valueSlots[valueIndex] = valueSlots[lastIndex];
+                slots[valueSlots[valueIndex]].valueIndex = valueIndex;
+            }
+            values.pop_back();
+            valueSlots.pop_back();
+
+            // Wraps around after MAX_GENERATION removals of the same slot, skipping the null generation
+            uint32_t& generation = slots[slot].generation;
+            generation = generation == HandleType::MAX_GENERATION ? 1 : generation + 1;
+            freeSlots.push_back(slot);
+            return true;
+        }
+
+        // nullptr when the handle is null or stale
+        T* get(HandleType handle) {
+            const Slot* found = findSlot(handle);
+            return found != nullptr ? &values[found->valueIndex] : nullptr;
+        }
+
+        const T* get(HandleType handle) const {
+            const Slot* found = findSlot(handle);
+            return found != nullptr ? &values[found->valueIndex] : nullptr;
+        }
+
+        // Swaps the resource behind a handle, every holder of the handle sees the new one
+        bool replace(HandleType handle, T value) {
+            T* current = get(handle);
+            if (current == nullptr)
+            {
+                return false;
+            }
+            *current = std::move(value);
+            return true;
+        }
+
+        [[nodiscard]]
+        bool contains(HandleType handle) const {
+            return findSlot(handle) != nullptr;
+        }
+
+        [[nodiscard]]
+        size_t size() const {
+            return values.size();
+        }
+
+        typename std::vector<T>::iterator begin() {
+            return values.begin();
+        }
+
+        typename std::vector<T>::iterator end() {
+            return values.end();
+        }
+
+        typename std::vector<T>::const_iterator begin() const {
+            return values.begin();
+        }
+
+        typename std::vector<T>::const_iterator end() const {
+            return values.end();
+        }
+    };
+
+} // dvk
+
+#endif //DRAFT_VK_SLOTMAP_HPP
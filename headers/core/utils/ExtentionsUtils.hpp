@@ -15,13 +15,13 @@
 
 namespace dvk::utils {
     extern std::vector<const char*> deviceExtensions;
-    std::vector<const char*> getRequiredExtensions();
+    std::vector<const char*> getRequiredExtensions(bool headless);
     void checkExtensionsCompatibility(
             std::vector<const char*>& glfwExtensions,
             std::vector<VkExtensionProperties>& vkCompatibleExtensions
     );
 
-    bool checkDeviceExensionsSupport(VkPhysicalDevice device);
+    bool checkDeviceExensionsSupport(VkPhysicalDevice device, const std::vector<const char*>& extensions);
 }
 
 
@@ -0,0 +1,23 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_IMAGEUTILS_HPP
+#define DRAFT_VK_IMAGEUTILS_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace dvk::utils {
+
+    // 8-bit RGBA PNG, rows rowPitch bytes apart. With bgra the red and blue channels are swapped on the way.
+    // Deflate blocks are stored uncompressed, there is no zlib to depend on: the files are as large as the pixels.
+    void writePng(const std::string& fileName, const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t rowPitch, bool bgra);
+    // Rows as they are, without any header
+    void writeRaw(const std::string& fileName, const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t rowPitch, uint32_t bytesPerPixel);
+    // FNV-1a of the rows' bytes, to compare captures without comparing files
+    uint64_t hashPixels(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t rowPitch, uint32_t bytesPerPixel);
+
+} // dvk
+
+#endif //DRAFT_VK_IMAGEUTILS_HPP
@@ -0,0 +1,19 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_MEMORYUTILS_HPP
+#define DRAFT_VK_MEMORYUTILS_HPP
+
+#include <vulkan/vulkan_core.h>
+#include <stdexcept>
+
+namespace dvk::utils {
+
+    uint32_t findMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeFilter, VkMemoryPropertyFlags properties);
+    // Same as findMemoryType, for callers that have a fallback when no type has all the properties
+    bool tryFindMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeFilter, VkMemoryPropertyFlags properties, uint32_t& memoryType);
+
+} // dvk
+
+#endif //DRAFT_VK_MEMORYUTILS_HPP
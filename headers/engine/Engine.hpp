@@ -7,6 +7,7 @@
 
 
 #include <GLFW/glfw3.h>
+#include <chrono>
 #include <memory>
 #include <iostream>
 #include "Window.hpp"
@@ -21,6 +22,7 @@
 #include "CommandBuffers.hpp"
 #include "Synchronization.hpp"
 #include "Core.hpp"
+#include "Options.hpp"
 
 namespace dvk {
     class Engine {
@@ -29,7 +31,7 @@ namespace dvk {
 
         void init();
     public:
-        Engine();
+        Engine(const Options& options, std::chrono::steady_clock::time_point processStart);
 
         void run();
     };
@@ -11,6 +11,19 @@ namespace dvk::constants {
     #else
             const bool enable_Validation_Layers = true;
     #endif
+
+    #ifdef DVK_RESOURCES_DIR
+            const char* const resources_Dir = DVK_RESOURCES_DIR;
+    #else
+            const char* const resources_Dir = "resources/";
+    #endif
+
+    // Compiled by the build from resources/shaders
+    #ifdef DVK_SHADERS_DIR
+            const char* const shaders_Dir = DVK_SHADERS_DIR;
+    #else
+            const char* const shaders_Dir = "shaders/";
+    #endif
     }
 
 #endif //DRAFT_VK_CONSTANTS_HPP
@@ -0,0 +1,78 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#ifndef DRAFT_VK_OPTIONS_HPP
+#define DRAFT_VK_OPTIONS_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace dvk {
+
+    struct Options {
+        bool headless = false;
+        uint32_t width = 1920;
+        uint32_t height = 1080;
+        // 0 runs until the window is closed, headless runs always have a fixed frame count.
+        // In benchmark mode this is the number of measured frames, run after the warm-up frames.
+        uint32_t frames = 0;
+        bool benchmark = false;
+        // Copies of the mesh drawn with one instanced draw, 0 draws the mesh once without instancing
+        uint32_t instances = 0;
+        // Draws the instances from a GPU scene, culled by a compute pass and drawn with vkCmdDrawIndirectCount
+        bool gpuDriven = false;
+        // Culls the GPU scene on the compute queue, overlapping the previous frame's graphics work
+        bool asyncCompute = false;
+        // Windowed only: draws a frame only on input, resize, expose or a scene change instead of continuously
+        bool onDemand = false;
+        // With onDemand, the longest time in milliseconds the window goes without a redraw
+        uint32_t maxIdleMs = 1000;
+        // Caps the frame rate with the frame pacer, 0 renders as fast as the present mode allows
+        uint32_t targetFps = 0;
+        // GPU frame time in milliseconds dynamic resolution scales the scene to hold, 0 renders at full resolution
+        double resolutionBudget = 0.0;
+        // Smallest fraction of the output's width and height dynamic resolution renders at
+        double minResolutionScale = 0.5;
+        uint32_t warmupFrames = 100;
+        std::string reportFormat = "json";
+        // Empty writes the report to stdout
+        std::string reportOutput;
+        // Chrome trace written on exit, requires a build with DVK_TRACING
+        std::string traceOutput;
+        // Prometheus textfile, rewritten every second while running and on exit
+        std::string metricsOutput;
+        // Passes nullptr as pAllocator instead of the tracking host allocator
+        bool systemAllocator = false;
+        // Host allocations per scope and leaks, printed to stderr once everything is destroyed
+        bool hostMemoryReport = false;
+        // Headless only: after the warm-up frames, fails if drawFrame allocates during the measured frames.
+        // Requires a build with DVK_ALLOCATION_HOOK.
+        bool checkFrameAllocations = false;
+        // Threads of the job system, the main thread included. 0 uses one per hardware thread.
+        uint32_t jobThreads = 0;
+        // Measures the job system's scheduling overhead and exits without rendering
+        bool jobBenchmark = false;
+        // Builds the renderer one stage after the other on the main thread instead of on the job system
+        bool serialStartup = false;
+        // Reports the startup stage timings and the time to the first frame, then exits
+        bool startupBenchmark = false;
+        // Least severe validation message written, "verbose", "info", "warning" or "error"
+        std::string debugSeverity = "warning";
+        // Messages written per validation message ID and second, 0 writes all of them
+        uint32_t debugRateLimit = 10;
+        // Counts the Vulkan calls of every frame and times the blocking ones, reported by --benchmark
+        bool countApiCalls = false;
+        // Directory read back frames are written to, F12 captures the next frame with a window. Off when empty.
+        std::string captureDir;
+        // Also captures every Nth frame, 0 only captures on F12
+        uint32_t captureEvery = 0;
+        // "png" or "raw"
+        std::string captureFormat = "png";
+    };
+
+    Options parseOptions(int argc, char** argv);
+
+} // dvk
+
+#endif //DRAFT_VK_OPTIONS_HPP
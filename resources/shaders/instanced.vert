@@ -0,0 +1,23 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec3 inColor;
+// Per instance: xy offset, zw scale
+layout(location = 2) in vec4 inTransform;
+layout(location = 3) in vec4 inInstanceColor;
+
+// Per draw, from the uniform ring
+layout(set = 1, binding = 0) uniform DrawUniforms {
+    // xy offset, zw scale, applied after the instance transform
+    vec4 transform;
+    vec4 color;
+} draw;
+
+layout(location = 0) out vec3 fragColor;
+
+void main() {
+    vec2 position = inPosition * inTransform.zw + inTransform.xy;
+    gl_Position = vec4(position * draw.transform.zw + draw.transform.xy, 0.0, 1.0);
+    fragColor = inColor * inInstanceColor.rgb * draw.color.rgb;
+}
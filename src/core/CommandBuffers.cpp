@@ -3,30 +3,48 @@
 //
 
 #include "CommandBuffers.hpp"
-#include "QueueFamilyIndices.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
 
 namespace dvk {
 
     CommandBuffers::CommandBuffers(
                 VkPhysicalDevice* physicalDevice,
                 VkDevice* device,
-                VkSurfaceKHR* surface,
+                const QueueFamilyIndices* queueFamilyIndices,
                 std::vector<VkFramebuffer>* swapchainFramebuffers,
+                std::vector<VkImage>* targetImages,
                 VkRenderPass* renderPass,
                 VkExtent2D* swapChainExtent,
-                VkPipeline* graphicsPipeline,
-                VkBuffer* vertexBuffer,
-                std::vector<Vertex>* vertices
+                ResourcePools* resourcePools,
+                RenderQueue* renderQueue,
+                InstanceBuffer* instanceBuffer,
+                GpuScene* gpuScene,
+                BindlessDescriptors* bindlessDescriptors,
+                UniformRing* uniformRing,
+                DynamicResolution* dynamicResolution,
+                GpuProfiler* gpuProfiler,
+                FrameReadback* frameReadback,
+                memory::FrameArenas* frameArenas
             ) :
             physicalDevice(physicalDevice),
             device(device),
-            surface(surface),
+            queueFamilyIndices(queueFamilyIndices),
             swapchainFramebuffers(swapchainFramebuffers),
+            targetImages(targetImages),
             renderPass(renderPass),
             swapChainExtent(swapChainExtent),
-            graphicsPipeline(graphicsPipeline),
-            vertexBuffer(vertexBuffer),
-            vertices(vertices)
+            resourcePools(resourcePools),
+            renderQueue(renderQueue),
+            instanceBuffer(instanceBuffer),
+            gpuScene(gpuScene),
+            bindlessDescriptors(bindlessDescriptors),
+            uniformRing(uniformRing),
+            dynamicResolution(dynamicResolution),
+            gpuProfiler(gpuProfiler),
+            frameReadback(frameReadback),
+            frameArenas(frameArenas),
+            rendererMetrics(&metrics::getRendererMetrics())
     {
         createCommandPool();
         createCommandBuffers();
@@ -36,19 +54,17 @@ namespace dvk {
     }
 
     CommandBuffers::~CommandBuffers() {
-        vkDestroyCommandPool(*device, commandPool, nullptr);
+        getDeviceDispatch().vkDestroyCommandPool(*device, commandPool, memory::getAllocationCallbacks());
     }
 
     void CommandBuffers::createCommandPool()
 {
-        QueueFamilyIndices queueFamilyIndices(physicalDevice, surface);
-
         VkCommandPoolCreateInfo commandPoolInfos{};
         commandPoolInfos.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-        commandPoolInfos.queueFamilyIndex = queueFamilyIndices.getGraphicsFamilyValue();
+        commandPoolInfos.queueFamilyIndex = queueFamilyIndices->getGraphicsFamilyValue();
         commandPoolInfos.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
 
-        if (vkCreateCommandPool(*device, &commandPoolInfos, nullptr, &commandPool) != VK_SUCCESS){
+        if (getDeviceDispatch().vkCreateCommandPool(*device, &commandPoolInfos, memory::getAllocationCallbacks(), &commandPool) != VK_SUCCESS){
             throw std::runtime_error("Failed to create command pool!");
         }
     }
@@ -63,7 +79,7 @@ namespace dvk {
         commandBufferAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
         commandBufferAllocInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
 
-        if (vkAllocateCommandBuffers(*device, &commandBufferAllocInfo, commandBuffers.data()) != VK_SUCCESS){
+        if (getDeviceDispatch().vkAllocateCommandBuffers(*device, &commandBufferAllocInfo, commandBuffers.data()) != VK_SUCCESS){
             throw std::runtime_error("Failed to allocate command buffers!");
         }
     }
@@ -72,55 +88,178 @@ namespace dvk {
         return &commandBuffers;
     }
 
+    void CommandBuffers::setRenderTargets(std::vector<VkFramebuffer>* swapchainFramebuffers, std::vector<VkImage>* targetImages, VkExtent2D* swapChainExtent) {
+        this->swapchainFramebuffers = swapchainFramebuffers;
+        this->targetImages = targetImages;
+        this->swapChainExtent = swapChainExtent;
+    }
+
     void CommandBuffers::recordCommandBuffer(int currentFrame, uint32_t imageIndex) {
-        vkResetCommandBuffer(commandBuffers[currentFrame], 0);
+        // Scratch arrays of the recording live in the frame's arena, they are dropped once its fence is waited on
+        memory::LinearArena* frameArena = &frameArenas->getArena(currentFrame);
+
+        getDeviceDispatch().vkResetCommandBuffer(commandBuffers[currentFrame], 0);
 
         VkCommandBufferBeginInfo cmdBufferBeginInfo{};
         cmdBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
         cmdBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
         cmdBufferBeginInfo.pInheritanceInfo = nullptr;
 
-        if (vkBeginCommandBuffer(commandBuffers[currentFrame], &cmdBufferBeginInfo) != VK_SUCCESS){
+        if (getDeviceDispatch().vkBeginCommandBuffer(commandBuffers[currentFrame], &cmdBufferBeginInfo) != VK_SUCCESS){
             throw std::runtime_error("Failed to begin recording command buffer!");
         }
 
-        VkClearValue clearColor = {0.0f, 0.0f, 0.0f, 1.0f};
+        gpuProfiler->beginFrame(commandBuffers[currentFrame], currentFrame);
+        uint32_t frameScope = gpuProfiler->beginScope(commandBuffers[currentFrame], currentFrame, "frame");
+        if (gpuScene != nullptr && !asyncCulling)
+        {
+            uint32_t cullingScope = gpuProfiler->beginScope(commandBuffers[currentFrame], currentFrame, "culling");
+            gpuScene->recordCulling(commandBuffers[currentFrame], currentFrame);
+            gpuProfiler->endScope(commandBuffers[currentFrame], currentFrame, cullingScope);
+        }
+        uint32_t mainPassScope = gpuProfiler->beginScope(commandBuffers[currentFrame], currentFrame, "main_pass");
+
+        memory::FrameVector<VkClearValue> clearValues{memory::ArenaAllocator<VkClearValue>(frameArena)};
+        clearValues.push_back(VkClearValue{{{0.0f, 0.0f, 0.0f, 1.0f}}});
+
+        // With dynamic resolution the scene covers the top left corner of the frame's scene image, whose pass is
+        // compatible with the output's, the pipelines are shared
+        VkExtent2D renderExtent = *swapChainExtent;
         VkRenderPassBeginInfo renderPassBeginInfo{};
         renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassBeginInfo.clearValueCount = 1;
+        renderPassBeginInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
         renderPassBeginInfo.framebuffer = (*swapchainFramebuffers)[imageIndex];
         renderPassBeginInfo.renderPass = *renderPass;
-        renderPassBeginInfo.pClearValues = &clearColor;
+        if (dynamicResolution != nullptr)
+        {
+            renderExtent = dynamicResolution->beginFrame(currentFrame);
+            renderPassBeginInfo.framebuffer = (*dynamicResolution->getFramebuffers())[currentFrame];
+            renderPassBeginInfo.renderPass = *dynamicResolution->getRenderPass();
+        }
+        renderPassBeginInfo.pClearValues = clearValues.data();
         renderPassBeginInfo.renderArea.offset = {0, 0};
-        renderPassBeginInfo.renderArea.extent = *swapChainExtent;
-        vkCmdBeginRenderPass(commandBuffers[currentFrame], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-        vkCmdBindPipeline(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, *graphicsPipeline);
+        renderPassBeginInfo.renderArea.extent = renderExtent;
+        getDeviceDispatch().vkCmdBeginRenderPass(commandBuffers[currentFrame], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
 
         VkViewport viewport{};
         viewport.x = 0.0f;
         viewport.y = 0.0f;
-        viewport.width = static_cast<float>(swapChainExtent->width);
-        viewport.height = static_cast<float>(swapChainExtent->height);
+        viewport.width = static_cast<float>(renderExtent.width);
+        viewport.height = static_cast<float>(renderExtent.height);
         viewport.minDepth = 0.0f;
         viewport.maxDepth = 1.0f;
-        vkCmdSetViewport(commandBuffers[currentFrame], 0, 1, &viewport);
+        getDeviceDispatch().vkCmdSetViewport(commandBuffers[currentFrame], 0, 1, &viewport);
 
         VkRect2D scissor{};
         scissor.offset = {0, 0};
-        scissor.extent = *swapChainExtent;
-        vkCmdSetScissor(commandBuffers[currentFrame], 0, 1, &scissor);
+        scissor.extent = renderExtent;
+        getDeviceDispatch().vkCmdSetScissor(commandBuffers[currentFrame], 0, 1, &scissor);
+
+        if (bindlessDescriptors != nullptr)
+        {
+            bindlessDescriptors->bind(commandBuffers[currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS);
+        }
 
-        VkBuffer vertexBuffers[] = {*vertexBuffer};
-        VkDeviceSize offsets[] = {0};
-        vkCmdBindVertexBuffers(commandBuffers[currentFrame], 0, 1, vertexBuffers, offsets);
+        uint32_t draws = recordDraws(commandBuffers[currentFrame], currentFrame);
+        if (gpuScene != nullptr)
+        {
+            draws += gpuScene->recordDraws(commandBuffers[currentFrame], currentFrame, uniformRing);
+        }
+        rendererMetrics->drawsPerFrame.observe(draws);
 
-        vkCmdDraw(commandBuffers[currentFrame], static_cast<uint32_t>(vertices->size()), 1, 0, 0);
+        getDeviceDispatch().vkCmdEndRenderPass(commandBuffers[currentFrame]);
+
+        gpuProfiler->endScope(commandBuffers[currentFrame], currentFrame, mainPassScope);
+
+        if (dynamicResolution != nullptr)
+        {
+            uint32_t upscaleScope = gpuProfiler->beginScope(commandBuffers[currentFrame], currentFrame, "upscale");
+            dynamicResolution->recordUpscale(commandBuffers[currentFrame], currentFrame, imageIndex);
+            gpuProfiler->endScope(commandBuffers[currentFrame], currentFrame, upscaleScope);
+        }
+        gpuProfiler->endScope(commandBuffers[currentFrame], currentFrame, frameScope);
 
-        vkCmdEndRenderPass(commandBuffers[currentFrame]);
+        // Outside the profiler's scopes, which must be the same every frame
+        if (frameReadback != nullptr)
+        {
+            frameReadback->record(commandBuffers[currentFrame], currentFrame, (*targetImages)[imageIndex], *swapChainExtent);
+        }
 
-        if (vkEndCommandBuffer(commandBuffers[currentFrame]) != VK_SUCCESS){
+        if (getDeviceDispatch().vkEndCommandBuffer(commandBuffers[currentFrame]) != VK_SUCCESS){
             throw std::runtime_error("Failed to record command buffer!");
         }
     }
+
+    void CommandBuffers::setAsyncCulling(bool asyncCulling) {
+        this->asyncCulling = asyncCulling;
+    }
+
+    uint32_t CommandBuffers::recordDraws(VkCommandBuffer commandBuffer, uint32_t frame)
+    {
+        if (instanceBuffer != nullptr)
+        {
+            VkDeviceSize instanceOffset = instanceBuffer->getFrameOffset(frame);
+            getDeviceDispatch().vkCmdBindVertexBuffers(commandBuffer, 1, 1, instanceBuffer->getBuffer(), &instanceOffset);
+        }
+
+        // The queue is sorted by state, a bind is only recorded when it differs from the previous draw's
+        VkPipeline boundPipeline = VK_NULL_HANDLE;
+        VkBuffer boundVertexBuffer = VK_NULL_HANDLE;
+        VkPipelineLayout boundLayout = VK_NULL_HANDLE;
+        uint32_t boundUniformOffset = 0;
+        uint64_t pipelineBinds = 0;
+        uint64_t skippedBinds = 0;
+        uint64_t triangles = 0;
+
+        for (uint32_t i = 0; i < renderQueue->size(); i++)
+        {
+            const DrawPacket& packet = renderQueue->getSorted(i);
+            const PipelineResource* pipelineResource = resourcePools->getPipelines()->get(packet.pipeline);
+            const MeshResource* meshResource = resourcePools->getMeshes()->get(packet.mesh);
+            const BufferResource* vertexBufferResource = meshResource ? resourcePools->getBuffers()->get(meshResource->vertexBuffer) : nullptr;
+            if (pipelineResource == nullptr || vertexBufferResource == nullptr)
+            {
+                throw std::runtime_error("Recording with a stale pipeline or mesh handle!");
+            }
+
+            if (pipelineResource->pipeline != boundPipeline)
+            {
+                getDeviceDispatch().vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineResource->pipeline);
+                boundPipeline = pipelineResource->pipeline;
+                pipelineBinds++;
+            }
+            else
+            {
+                skippedBinds++;
+            }
+
+            if (vertexBufferResource->buffer != boundVertexBuffer)
+            {
+                VkDeviceSize vertexOffset = 0;
+                getDeviceDispatch().vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBufferResource->buffer, &vertexOffset);
+                boundVertexBuffer = vertexBufferResource->buffer;
+            }
+            else
+            {
+                skippedBinds++;
+            }
+
+            // Layouts share the uniform set, a new layout alone does not disturb it but a new offset needs a rebind
+            if (uniformRing != nullptr && (boundLayout == VK_NULL_HANDLE || packet.uniformOffset != boundUniformOffset))
+            {
+                uniformRing->bind(commandBuffer, pipelineResource->layout, frame, packet.uniformOffset);
+                boundLayout = pipelineResource->layout;
+                boundUniformOffset = packet.uniformOffset;
+            }
+
+            getDeviceDispatch().vkCmdDraw(commandBuffer, meshResource->vertexCount, packet.instanceCount, meshResource->firstVertex, packet.firstInstance);
+            triangles += static_cast<uint64_t>(meshResource->vertexCount / 3) * packet.instanceCount;
+        }
+
+        rendererMetrics->pipelineBinds.add(pipelineBinds);
+        rendererMetrics->skippedBinds.add(skippedBinds);
+        rendererMetrics->drawCalls.add(renderQueue->size());
+        rendererMetrics->triangles.add(triangles);
+        return renderQueue->size();
+    }
 } // dvk
\ No newline at end of file
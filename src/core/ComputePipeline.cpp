@@ -0,0 +1,232 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <vulkan/vulkan_core.h>
+#include <stdexcept>
+#include <map>
+#include "ComputePipeline.hpp"
+#include "ShadersUtils.hpp"
+#include "Constants.hpp"
+#include "Trace.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
+
+namespace dvk {
+    ComputePipeline::ComputePipeline(
+            VkDevice* device,
+            const std::string& shaderFile,
+            std::vector<VkDescriptorSetLayoutBinding> bindings,
+            uint32_t pushConstantSize,
+            uint32_t maxDescriptorSets,
+            ResourcePools* resourcePools
+            ) :
+        device(device),
+        bindings(std::move(bindings)),
+        pushConstantSize(pushConstantSize),
+        maxDescriptorSets(maxDescriptorSets),
+        resourcePools(resourcePools)
+    {
+        createDescriptorSetLayout();
+        createDescriptorPool();
+        createComputePipeline(shaderFile);
+        pipelineHandle = resourcePools->getPipelines()->insert(PipelineResource{computePipeline, pipelineLayout});
+    }
+
+    ComputePipeline::~ComputePipeline() {
+        resourcePools->getPipelines()->remove(pipelineHandle);
+
+        getDeviceDispatch().vkDestroyShaderModule(*device, shaderModule, memory::getAllocationCallbacks());
+        getDeviceDispatch().vkDestroyPipeline(*device, computePipeline, memory::getAllocationCallbacks());
+        getDeviceDispatch().vkDestroyPipelineLayout(*device, pipelineLayout, memory::getAllocationCallbacks());
+        getDeviceDispatch().vkDestroyDescriptorPool(*device, descriptorPool, memory::getAllocationCallbacks());
+        getDeviceDispatch().vkDestroyDescriptorSetLayout(*device, descriptorSetLayout, memory::getAllocationCallbacks());
+    }
+
+    VkShaderModule ComputePipeline::createShaderModule(const std::vector<char>& code)
+    {
+        VkShaderModuleCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        createInfo.codeSize = code.size();
+        createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+
+        VkShaderModule module;
+        if (getDeviceDispatch().vkCreateShaderModule(*device, &createInfo, memory::getAllocationCallbacks(), &module) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create shader module!");
+        }
+
+        return module;
+    }
+
+    void ComputePipeline::createDescriptorSetLayout()
+    {
+        for (auto& binding : bindings)
+        {
+            binding.stageFlags |= VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        if (getDeviceDispatch().vkCreateDescriptorSetLayout(*device, &layoutInfo, memory::getAllocationCallbacks(), &descriptorSetLayout) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create compute descriptor set layout!");
+        }
+    }
+
+    void ComputePipeline::createDescriptorPool()
+    {
+        if (bindings.empty() || maxDescriptorSets == 0)
+        {
+            return;
+        }
+
+        std::map<VkDescriptorType, uint32_t> descriptorCounts;
+        for (const auto& binding : bindings)
+        {
+            descriptorCounts[binding.descriptorType] += binding.descriptorCount * maxDescriptorSets;
+        }
+
+        std::vector<VkDescriptorPoolSize> poolSizes;
+        for (const auto& [type, count] : descriptorCounts)
+        {
+            poolSizes.push_back(VkDescriptorPoolSize{type, count});
+        }
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = maxDescriptorSets;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes = poolSizes.data();
+
+        if (getDeviceDispatch().vkCreateDescriptorPool(*device, &poolInfo, memory::getAllocationCallbacks(), &descriptorPool) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create compute descriptor pool!");
+        }
+    }
+
+    void ComputePipeline::createComputePipeline(const std::string& shaderFile)
+    {
+        DVK_TRACE_ZONE("createComputePipeline");
+        auto shaderCode = utils::readFile(std::string(constants::shaders_Dir) + shaderFile);
+        shaderModule = createShaderModule(shaderCode);
+
+        VkPipelineShaderStageCreateInfo shaderStageInfo{};
+        shaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        shaderStageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        shaderStageInfo.module = shaderModule;
+        shaderStageInfo.pName = "main";
+
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = pushConstantSize;
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = pushConstantSize > 0 ? 1 : 0;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (getDeviceDispatch().vkCreatePipelineLayout(*device, &pipelineLayoutInfo, memory::getAllocationCallbacks(), &pipelineLayout) != VK_SUCCESS){
+            throw std::runtime_error("Failed to create compute pipeline layout!");
+        }
+
+        VkComputePipelineCreateInfo computePipelineInfo{};
+        computePipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        computePipelineInfo.stage = shaderStageInfo;
+        computePipelineInfo.layout = pipelineLayout;
+        computePipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+        computePipelineInfo.basePipelineIndex = -1;
+
+        if (getDeviceDispatch().vkCreateComputePipelines(*device, VK_NULL_HANDLE, 1, &computePipelineInfo, memory::getAllocationCallbacks(), &computePipeline) != VK_SUCCESS){
+            throw std::runtime_error("Failed to create compute pipeline!");
+        }
+    }
+
+    VkDescriptorSet ComputePipeline::allocateDescriptorSet()
+    {
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &descriptorSetLayout;
+
+        VkDescriptorSet descriptorSet;
+        if (descriptorPool == VK_NULL_HANDLE || getDeviceDispatch().vkAllocateDescriptorSets(*device, &allocInfo, &descriptorSet) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to allocate compute descriptor set!");
+        }
+
+        return descriptorSet;
+    }
+
+    void ComputePipeline::writeBuffer(VkDescriptorSet descriptorSet, uint32_t binding, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+    {
+        const VkDescriptorSetLayoutBinding* layoutBinding = nullptr;
+        for (const auto& candidate : bindings)
+        {
+            if (candidate.binding == binding)
+            {
+                layoutBinding = &candidate;
+            }
+        }
+        if (layoutBinding == nullptr)
+        {
+            throw std::runtime_error("Writing a buffer to a binding missing from the compute layout!");
+        }
+
+        VkDescriptorBufferInfo bufferInfo{};
+        bufferInfo.buffer = buffer;
+        bufferInfo.offset = offset;
+        bufferInfo.range = range;
+
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = descriptorSet;
+        write.dstBinding = binding;
+        write.descriptorCount = 1;
+        write.descriptorType = layoutBinding->descriptorType;
+        write.pBufferInfo = &bufferInfo;
+
+        getDeviceDispatch().vkUpdateDescriptorSets(*device, 1, &write, 0, nullptr);
+    }
+
+    void ComputePipeline::bind(VkCommandBuffer commandBuffer, VkDescriptorSet descriptorSet) {
+        getDeviceDispatch().vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
+        getDeviceDispatch().vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+    }
+
+    void ComputePipeline::pushConstants(VkCommandBuffer commandBuffer, const void* data, uint32_t size)
+    {
+        if (size > pushConstantSize)
+        {
+            throw std::runtime_error("Push constants exceed the compute pipeline's range!");
+        }
+        getDeviceDispatch().vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, size, data);
+    }
+
+    void ComputePipeline::dispatch(VkCommandBuffer commandBuffer, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+        getDeviceDispatch().vkCmdDispatch(commandBuffer, groupCountX, groupCountY, groupCountZ);
+    }
+
+    VkPipeline *ComputePipeline::getComputePipeline() {
+        return &computePipeline;
+    }
+
+    VkPipelineLayout *ComputePipeline::getPipelineLayout() {
+        return &pipelineLayout;
+    }
+
+    VkDescriptorSetLayout *ComputePipeline::getDescriptorSetLayout() {
+        return &descriptorSetLayout;
+    }
+
+    PipelineHandle ComputePipeline::getPipelineHandle() const {
+        return pipelineHandle;
+    }
+} // dvk
@@ -0,0 +1,134 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <stdexcept>
+#include "ComputeScheduler.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
+
+namespace dvk {
+    ComputeScheduler::ComputeScheduler(VkDevice* device, VkQueue* computeQueue, uint32_t computeFamily, uint32_t framesInFlight) :
+        device(device),
+        computeQueue(computeQueue),
+        computeFamily(computeFamily),
+        framesInFlight(framesInFlight),
+        pending(framesInFlight, false),
+        rendererMetrics(&metrics::getRendererMetrics())
+    {
+        createCommandPool();
+        createCommandBuffers();
+        createSemaphores();
+    }
+
+    ComputeScheduler::~ComputeScheduler() {
+        getDeviceDispatch().vkQueueWaitIdle(*computeQueue);
+        for (auto semaphore : finishedSemaphores)
+        {
+            getDeviceDispatch().vkDestroySemaphore(*device, semaphore, memory::getAllocationCallbacks());
+        }
+        getDeviceDispatch().vkDestroyCommandPool(*device, commandPool, memory::getAllocationCallbacks());
+    }
+
+    void ComputeScheduler::createCommandPool()
+    {
+        VkCommandPoolCreateInfo commandPoolInfos{};
+        commandPoolInfos.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        commandPoolInfos.queueFamilyIndex = computeFamily;
+        commandPoolInfos.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+
+        if (getDeviceDispatch().vkCreateCommandPool(*device, &commandPoolInfos, memory::getAllocationCallbacks(), &commandPool) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create compute command pool!");
+        }
+    }
+
+    void ComputeScheduler::createCommandBuffers()
+    {
+        commandBuffers.resize(framesInFlight);
+
+        VkCommandBufferAllocateInfo commandBufferAllocInfo{};
+        commandBufferAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        commandBufferAllocInfo.commandPool = commandPool;
+        commandBufferAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        commandBufferAllocInfo.commandBufferCount = framesInFlight;
+
+        if (getDeviceDispatch().vkAllocateCommandBuffers(*device, &commandBufferAllocInfo, commandBuffers.data()) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to allocate compute command buffers!");
+        }
+    }
+
+    void ComputeScheduler::createSemaphores()
+    {
+        finishedSemaphores.resize(framesInFlight);
+
+        VkSemaphoreCreateInfo semaphoreInfos{};
+        semaphoreInfos.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+        for (auto& semaphore : finishedSemaphores)
+        {
+            if (getDeviceDispatch().vkCreateSemaphore(*device, &semaphoreInfos, memory::getAllocationCallbacks(), &semaphore) != VK_SUCCESS)
+            {
+                throw std::runtime_error("Failed to create compute semaphore!");
+            }
+        }
+    }
+
+    VkCommandBuffer ComputeScheduler::begin(uint32_t frame)
+    {
+        if (pending[frame])
+        {
+            throw std::runtime_error("Compute work of the frame was submitted but never waited on!");
+        }
+
+        getDeviceDispatch().vkResetCommandBuffer(commandBuffers[frame], 0);
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        if (getDeviceDispatch().vkBeginCommandBuffer(commandBuffers[frame], &beginInfo) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to begin recording compute command buffer!");
+        }
+
+        return commandBuffers[frame];
+    }
+
+    void ComputeScheduler::submit(uint32_t frame)
+    {
+        if (getDeviceDispatch().vkEndCommandBuffer(commandBuffers[frame]) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to record compute command buffer!");
+        }
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &commandBuffers[frame];
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &finishedSemaphores[frame];
+
+        if (getDeviceDispatch().vkQueueSubmit(*computeQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to submit compute queue!");
+        }
+        rendererMetrics->queueSubmits.add();
+        pending[frame] = true;
+    }
+
+    VkSemaphore* ComputeScheduler::getFinishedSemaphore(uint32_t frame) {
+        pending[frame] = false;
+        return &finishedSemaphores[frame];
+    }
+
+    bool ComputeScheduler::isPending(uint32_t frame) const {
+        return pending[frame];
+    }
+
+    VkPipelineStageFlags ComputeScheduler::getWaitStage() {
+        // Compute results are consumed as indirect arguments and vertex attributes
+        return VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+    }
+} // dvk
@@ -3,130 +3,108 @@
 //
 
 #include "Core.hpp"
+#include "Trace.hpp"
+#include "AllocationCounter.hpp"
+#include "DebugMessageSink.hpp"
+#include "DeviceDispatch.hpp"
+#include "ApiCallCounter.hpp"
 #include <chrono>
+#include <cmath>
 #include <memory>
 #include <iomanip>
+#include <fstream>
+#include <thread>
 
 namespace dvk::Core {
-    Core::Core() :
-            window(std::make_unique<Window>()),
-            instance(std::make_unique<Instance>()),
-            debug(std::make_unique<Debug>(instance->getInstance())),
-            surface(std::make_unique<Surface>(window->getRawWindow(), instance->getInstance())),
-            device(std::make_unique<Device>(instance->getInstance(), surface->getSurface())),
-            swapchain(
-                    std::make_unique<Swapchain>(
-                            window->getRawWindow(),
-                            surface->getSurface(),
-                            device->getPhysicalDevice(),
-                            device->getDevice()
-                            )
-            ),
-            swapchainImageViews(
-                    std::make_unique<SwapchainImageViews>(
-                            device->getDevice(),
-                            swapchain->getSwapchainImages(),
-                            swapchain->getSwapchainImageFormat()
-                            )
-            ),
-            renderPass(std::make_unique<RenderPass>(device->getDevice(), swapchain->getSwapchainImageFormat())),
-            graphicsPipeline(
-                    std::make_unique<GraphicsPipeline>(
-                            device->getDevice(),
-                            renderPass->getRenderPass(),
-                            swapchain->getSwapchainExtent()
-                            )
-            ),
-            framebuffers(
-                    std::make_unique<Framebuffers>(
-                            device->getDevice(),
-                            swapchainImageViews->getSwapchainImageViews(),
-                            renderPass->getRenderPass(),
-                            swapchain->getSwapchainExtent()
-                            )
-            ),
-            vertexBuffer(
-                    std::make_unique<VertexBuffer>(
-                            device->getDevice(),
-                            device->getPhysicalDevice(),
-                            device->getGraphicsQueue(),
-                            surface->getSurface()
-                            )
-            ),
-            commandBuffers(
-                    std::make_unique<CommandBuffers>(
-                            device->getPhysicalDevice(),
-                            device->getDevice(),
-                            surface->getSurface(),
-                            framebuffers->getFramebuffers(),
-                            renderPass->getRenderPass(),
-                            swapchain->getSwapchainExtent(),
-                            graphicsPipeline->getGraphicsPipeline(),
-                            vertexBuffer->getVertexBuffer(),
-                            vertexBuffer->getVertices()
-                            )
-            ),
-            synchronization(
-                    std::make_unique<Synchronization>(
-                            device->getDevice(),
-                            swapchain->getSwapchainImages(),
-                            device->getGraphicsQueue(),
-                            MAX_FRAMES_IN_FLIGHT
-                            )
-            )
-    {
+    using Clock = std::chrono::steady_clock;
 
+    static double toMilliseconds(Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
     }
 
-    void Core::drawFrame()
+    Core::Core(const Options& options, Clock::time_point processStart) :
+            options(options),
+            processStart(processStart),
+            resourcePools(std::make_unique<ResourcePools>()),
+            jobSystem(std::make_unique<jobs::JobSystem>(options.jobThreads)),
+            startupGraph(std::make_unique<StartupGraph>(jobSystem.get())),
+            pipelineExtent{options.width, options.height},
+            frameArenas(std::make_unique<memory::FrameArenas>(MAX_FRAMES_IN_FLIGHT, jobSystem->getConcurrency(), memory::DEFAULT_FRAME_ARENA_SIZE)),
+            renderQueue(std::make_unique<RenderQueue>(jobSystem.get())),
+            benchmark(options.benchmark ? std::make_unique<Benchmark>(options.warmupFrames, options.frames, options.targetFps != 0) : nullptr),
+            framePacer(options.targetFps == 0 ? nullptr : std::make_unique<FramePacer>(options.targetFps)),
+            reportFormat(Benchmark::parseReportFormat(options.reportFormat)),
+            cpuBusyTimes(MAX_FRAMES_IN_FLIGHT, 0.0),
+            rendererMetrics(&metrics::getRendererMetrics())
     {
-//        auto start = std::chrono::high_resolution_clock::now();
+        DVK_TRACE_THREAD_NAME("main");
+        // Before init(), the instance's messenger subscribes to the severities that pass the filter
+        getDebugMessageSink().setMinSeverity(DebugMessageSink::parseSeverity(options.debugSeverity));
+        getDebugMessageSink().setRateLimit(options.debugRateLimit);
+        // Also before init(), the device's dispatch table is built with or without the counting wrappers
+        getApiCallCounter().setEnabled(options.countApiCalls);
+        init();
+        commandBuffers->setAsyncCulling(computeScheduler != nullptr);
+    }
 
-        vkWaitForFences(*(device->getDevice()), 1, &(*(synchronization->getInFlightFences()))[currentFrame], VK_TRUE, UINT64_MAX);
+    VkSurfaceKHR* Core::getSurface() {
+        return surface ? surface->getSurface() : &headlessSurface;
+    }
 
-        uint32_t imageIndex;
-        VkResult result = vkAcquireNextImageKHR(*(device->getDevice()), *(swapchain->getSwapChain()), UINT64_MAX, (*(synchronization->getImageAvailableSemaphores()))[currentFrame], VK_NULL_HANDLE, &imageIndex);
+    std::vector<VkImage>* Core::getTargetImages() {
+        return swapchain ? swapchain->getSwapchainImages() : offscreenTargets->getImages();
+    }
+
+    VkFormat* Core::getTargetImageFormat() {
+        return swapchain ? swapchain->getSwapchainImageFormat() : offscreenTargets->getImageFormat();
+    }
+
+    VkExtent2D* Core::getTargetExtent() {
+        return swapchain ? swapchain->getSwapchainExtent() : offscreenTargets->getExtent();
+    }
+
+    bool Core::acquireNextImage(uint32_t& imageIndex)
+    {
+        DVK_TRACE_ZONE("acquire");
+        if (options.headless)
+        {
+            // The offscreen ring holds one image per frame in flight, the fence waited on above already guards it
+            imageIndex = static_cast<uint32_t>(currentFrame);
+            return true;
+        }
+
+        VkResult result = getDeviceDispatch().vkAcquireNextImageKHR(*(device->getDevice()), *(swapchain->getSwapChain()), UINT64_MAX, (*(synchronization->getImageAvailableSemaphores()))[currentFrame], VK_NULL_HANDLE, &imageIndex);
 
         if (result == VK_ERROR_OUT_OF_DATE_KHR) {
             this->recreateSwapchain();
-            return;
+            return false;
         } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
             throw std::runtime_error("failed to acquire swap chain image!");
         }
 
-        vkResetFences(*(device->getDevice()), 1, &(*(synchronization->getInFlightFences()))[currentFrame]);
-
-        commandBuffers->recordCommandBuffer(currentFrame, imageIndex);
-
-        VkSemaphore waitSemaphores[] = {(*(synchronization->getImageAvailableSemaphores()))[currentFrame]};
-        VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-        VkSemaphore signalSemaphore[] = {(*(synchronization->getRenderFinishedSemaphores()))[currentFrame]};
-
-        VkSubmitInfo submitInfo{};
-        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.waitSemaphoreCount = 1;
-        submitInfo.pWaitSemaphores = waitSemaphores;
-        submitInfo.pWaitDstStageMask = waitStages;
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &(*(commandBuffers->getCommandBuffer()))[currentFrame];
-        submitInfo.signalSemaphoreCount = 1;
-        submitInfo.pSignalSemaphores = signalSemaphore;
+        return true;
+    }
 
-        if (vkQueueSubmit(*(device->getGraphicsQueue()), 1, &submitInfo, (*(synchronization->getInFlightFences()))[currentFrame]) != VK_SUCCESS){
-            throw std::runtime_error("Failed to submit graphics queue!");
+    void Core::presentImage(uint32_t imageIndex)
+    {
+        DVK_TRACE_ZONE("present");
+        if (options.headless)
+        {
+            return;
         }
 
+        VkSemaphore waitSemaphores[] = {(*(synchronization->getRenderFinishedSemaphores()))[currentFrame]};
         VkSwapchainKHR swapChains[] = {*(swapchain->getSwapChain())};
         VkPresentInfoKHR presentInfo{};
         presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-        presentInfo.pWaitSemaphores = signalSemaphore;
+        presentInfo.pWaitSemaphores = waitSemaphores;
         presentInfo.swapchainCount = 1;
         presentInfo.pSwapchains = swapChains;
         presentInfo.pImageIndices = &imageIndex;
         presentInfo.pResults = nullptr;
         presentInfo.waitSemaphoreCount = 1;
 
-        result = vkQueuePresentKHR(*(device->getPresentationQueue()), &presentInfo);
+        VkResult result = getDeviceDispatch().vkQueuePresentKHR(*(device->getPresentationQueue()), &presentInfo);
 
         if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || window->isFramebufferResized()) {
             window->setFramebufferResized(false);
@@ -134,47 +112,690 @@ namespace dvk::Core {
         } else if (result != VK_SUCCESS) {
             throw std::runtime_error("failed to acquire swap chain image!");
         }
+    }
+
+    void Core::drawFrame()
+    {
+        DVK_TRACE_ZONE("drawFrame");
+        auto frameStart = Clock::now();
+
+        {
+            DVK_TRACE_ZONE("wait");
+            getDeviceDispatch().vkWaitForFences(*(device->getDevice()), 1, &(*(synchronization->getInFlightFences()))[currentFrame], VK_TRUE, UINT64_MAX);
+        }
+        auto waitEnd = Clock::now();
+        rendererMetrics->fenceWaitSeconds.observe(std::chrono::duration<double>(waitEnd - frameStart).count());
+        frameArenas->beginFrame(currentFrame);
+        uniformRing->beginFrame(currentFrame);
+        if (frameReadback) {
+            frameReadback->beginFrame(currentFrame, frameNumber);
+        }
+        // Paced after the fence wait but before the snapshot is taken and the frame recorded, so the sleep does
+        // not add to the latency between the input it samples and the frame it shows
+        double pacingError = 0.0;
+        if (framePacer) {
+            DVK_TRACE_ZONE("pace");
+            pacingError = framePacer->wait();
+            rendererMetrics->pacingErrorSeconds.observe(pacingError);
+            if (window) {
+                window->addPacingError(pacingError * 1000.0);
+            }
+        }
+        auto paceEnd = Clock::now();
+
+        // The previous snapshot is drawn again when the event loop has not published a newer one
+        snapshots.acquire();
+
+        FrameTimings timings{};
+        if (gpuProfiler->collect(currentFrame, timings.gpu)) {
+            timings.bound = timings.gpu.total >= cpuBusyTimes[currentFrame] ? FrameBound::Gpu : FrameBound::Cpu;
+            if (window) {
+                window->setGpuFrameTime(timings.gpu.total);
+            }
+            if (dynamicResolution) {
+                dynamicResolution->update(currentFrame, timings.gpu.total);
+            }
+        }
 
+        uint32_t imageIndex;
+        if (!acquireNextImage(imageIndex)) {
+            return;
+        }
+        auto acquireEnd = Clock::now();
+
+        // Only frames that reach the GPU age the released slots, a failed acquire returns before submitting
+        if (bindlessDescriptors) {
+            bindlessDescriptors->beginFrame();
+        }
+
+        // Once acquired, a frame retried after a swapchain recreation is not asked for twice
+        if (frameReadback) {
+            bool periodic = options.captureEvery > 0 && (frameNumber + 1) % options.captureEvery == 0;
+            bool screenshot = window && window->consumeScreenshotRequest();
+            if (periodic || screenshot) {
+                frameReadback->request([this](ReadbackImage image) {
+                    frameCapture->submit(std::move(image));
+                });
+            }
+        }
+
+        getDeviceDispatch().vkResetFences(*(device->getDevice()), 1, &(*(synchronization->getInFlightFences()))[currentFrame]);
+
+        if (instanceBuffer) {
+            DVK_TRACE_ZONE("instances");
+            instanceBuffer->beginFrame(currentFrame);
+            writeInstances();
+        }
+
+        {
+            DVK_TRACE_ZONE("sort");
+            buildRenderQueue();
+        }
+
+        if (computeScheduler) {
+            DVK_TRACE_ZONE("compute");
+            VkCommandBuffer computeCommands = computeScheduler->begin(currentFrame);
+            gpuScene->recordCulling(computeCommands, currentFrame);
+            computeScheduler->submit(currentFrame);
+        }
+
+        {
+            DVK_TRACE_ZONE("record");
+            commandBuffers->recordCommandBuffer(currentFrame, imageIndex);
+        }
+        auto recordEnd = Clock::now();
+
+        // Headless frames are neither acquired nor presented, so there is nothing to wait on or signal
+        VkSemaphore waitSemaphores[2];
+        VkPipelineStageFlags waitStages[2];
+        uint32_t waitSemaphoreCount = 0;
+        if (!options.headless) {
+            waitSemaphores[waitSemaphoreCount] = (*(synchronization->getImageAvailableSemaphores()))[currentFrame];
+            waitStages[waitSemaphoreCount++] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        }
+        if (computeScheduler) {
+            waitSemaphores[waitSemaphoreCount] = *computeScheduler->getFinishedSemaphore(currentFrame);
+            waitStages[waitSemaphoreCount++] = ComputeScheduler::getWaitStage();
+        }
+        VkSemaphore signalSemaphore[] = {(*(synchronization->getRenderFinishedSemaphores()))[currentFrame]};
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.waitSemaphoreCount = waitSemaphoreCount;
+        submitInfo.pWaitSemaphores = waitSemaphores;
+        submitInfo.pWaitDstStageMask = waitStages;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &(*(commandBuffers->getCommandBuffer()))[currentFrame];
+        submitInfo.signalSemaphoreCount = options.headless ? 0 : 1;
+        submitInfo.pSignalSemaphores = signalSemaphore;
+
+        {
+            DVK_TRACE_ZONE("submit");
+            gpuProfiler->markSubmitted(currentFrame);
+            if (getDeviceDispatch().vkQueueSubmit(*(device->getGraphicsQueue()), 1, &submitInfo, (*(synchronization->getInFlightFences()))[currentFrame]) != VK_SUCCESS){
+                throw std::runtime_error("Failed to submit graphics queue!");
+            }
+        }
+        rendererMetrics->queueSubmits.add();
+        auto submitEnd = Clock::now();
+
+        presentImage(imageIndex);
+        auto presentEnd = Clock::now();
+
+        // Fence wait and acquire are time spent blocked on the GPU or the display, not CPU work
+        cpuBusyTimes[currentFrame] = toMilliseconds(presentEnd - acquireEnd);
         currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+        frameNumber++;
+        rendererMetrics->frames.add();
+
+        if (getApiCallCounter().isEnabled()) {
+            getApiCallCounter().endFrame(timings.api);
+        }
+
+        if (benchmark) {
+            timings[FramePhase::Wait] = toMilliseconds(waitEnd - frameStart);
+            timings[FramePhase::Pace] = toMilliseconds(paceEnd - waitEnd);
+            timings[FramePhase::Acquire] = toMilliseconds(acquireEnd - paceEnd);
+            timings[FramePhase::Record] = toMilliseconds(recordEnd - acquireEnd);
+            timings[FramePhase::Submit] = toMilliseconds(submitEnd - recordEnd);
+            timings[FramePhase::Present] = toMilliseconds(presentEnd - submitEnd);
+            timings.total = toMilliseconds(presentEnd - frameStart);
+            timings.pacingError = pacingError * 1000.0;
+            benchmark->recordFrame(timings);
+        }
+    }
+
+    std::unique_ptr<GpuScene> Core::createGpuScene() {
+        if (!device->supportsGpuDrivenRendering()) {
+            throw std::runtime_error("--gpu-driven needs drawIndirectCount, multiDrawIndirect and drawIndirectFirstInstance!");
+        }
+
+        // Culled on the compute family with --async-compute, the buffers are then shared with it
+        const QueueFamilyIndices* queueFamilyIndices = device->getQueueFamilyIndices();
+        std::vector<uint32_t> queueFamilies{queueFamilyIndices->getGraphicsFamilyValue()};
+        if (options.asyncCompute && queueFamilyIndices->getComputeFamilyValue() != queueFamilyIndices->getGraphicsFamilyValue()) {
+            queueFamilies.push_back(queueFamilyIndices->getComputeFamilyValue());
+        }
+
+        auto scene = std::make_unique<GpuScene>(
+                device->getPhysicalDevice(),
+                device->getDevice(),
+                options.instances,
+                1,
+                MAX_FRAMES_IN_FLIGHT,
+                queueFamilies,
+                resourcePools.get()
+                );
+        uint32_t mesh = scene->addMesh(vertexBuffer->getMeshHandle(), *vertexBuffer->getVertices());
+        uint32_t batch = scene->addBatch(graphicsPipeline->getPipelineHandle());
+
+        // The same grid as the instanced path, spread over twice the view so that culling rejects three quarters of it
+        layoutInstanceGrid(options.instances, 2.0f, [&](uint32_t, float u, float v, const glm::vec4& transform) {
+            InstanceData instance{};
+            instance.transform = transform;
+            instance.color = glm::vec4(u, v, 1.0f, 1.0f);
+            scene->addObject(mesh, batch, instance);
+        });
+
+        return scene;
+    }
+
+    std::unique_ptr<DynamicResolution> Core::createDynamicResolution() {
+        if (swapchain && (swapchain->getImageUsage() & VK_IMAGE_USAGE_TRANSFER_DST_BIT) == 0) {
+            throw std::runtime_error("--resolution-budget blits into the swapchain images, the surface does not allow transfers to them!");
+        }
+
+        return std::make_unique<DynamicResolution>(
+                device->getPhysicalDevice(),
+                device->getDevice(),
+                getTargetImageFormat(),
+                getTargetImages(),
+                *getTargetExtent(),
+                options.headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                MAX_FRAMES_IN_FLIGHT,
+                options.resolutionBudget,
+                options.minResolutionScale,
+                resourcePools.get()
+                );
+    }
+
+    void Core::writeInstances() {
+        // A grid of copies of the mesh filling the target, rewritten every frame with a pulsing color
+        uint32_t count = options.instances;
+        InstanceData* instances = instanceBuffer->allocate(currentFrame, vertexBuffer->getMeshHandle(), count);
+
+        float pulse = snapshots.getReadSlot().pulse;
+        layoutInstanceGrid(count, 1.0f, [&](uint32_t index, float u, float v, const glm::vec4& transform) {
+            instances[index].transform = transform;
+            instances[index].color = glm::vec4(u, v, pulse, 1.0f);
+        });
+    }
+
+    void Core::buildRenderQueue() {
+        renderQueue->clear();
+
+        DrawPacket packet{};
+        packet.pipeline = graphicsPipeline->getPipelineHandle();
+        if (instanceBuffer) {
+            for (const InstancedDraw& draw : *instanceBuffer->getDraws(currentFrame)) {
+                packet.mesh = draw.mesh;
+                packet.firstInstance = draw.firstInstance;
+                packet.instanceCount = draw.instanceCount;
+                writeDrawUniforms(packet);
+                renderQueue->submit(packet);
+            }
+        } else if (!gpuScene) {
+            packet.mesh = vertexBuffer->getMeshHandle();
+            writeDrawUniforms(packet);
+            renderQueue->submit(packet);
+        }
 
-//        auto end = std::chrono::high_resolution_clock::now();
-//        auto time_taken = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
-//        std::cout << "Frame drawn - time taken: " << time_taken << " " << "microseconds" << std::endl;
+        renderQueue->sort();
+    }
+
+    void Core::writeDrawUniforms(DrawPacket& packet) {
+        auto* uniforms = uniformRing->allocate<DrawUniforms>(currentFrame, packet.uniformOffset);
+        uniforms->transform = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+        uniforms->color = glm::vec4(1.0f);
+    }
+
+    void Core::simulate(double time) {
+        SceneSnapshot& snapshot = snapshots.getWriteSlot();
+        snapshot.sequence = ++publishedSnapshots;
+        snapshot.time = time;
+        snapshot.pulse = 0.5f + 0.5f * std::sin(static_cast<float>(time) * 3.0f);
+        snapshots.publish();
+    }
+
+    void Core::requestFrame() {
+        redrawRequests.fetch_add(1);
+        redrawRequests.notify_one();
+    }
+
+    void Core::markSceneDirty() {
+        sceneDirty = true;
+        if (window) {
+            window->wakeUp();
+        }
+    }
+
+    double Core::handleEvents(double time) {
+        if (!options.onDemand) {
+            simulate(time);
+            return SIMULATION_STEP;
+        }
+
+        // Only a drawn frame shows the simulation, so it advances only when one is requested
+        double maxIdle = options.maxIdleMs / 1000.0;
+        bool windowChanged = window->consumeRedrawRequest();
+        bool dirty = sceneDirty.exchange(false);
+        if (windowChanged || dirty || time - lastRedrawTime >= maxIdle) {
+            simulate(time);
+            requestFrame();
+            lastRedrawTime = time;
+        }
+        return std::max(lastRedrawTime + maxIdle - time, 0.0);
+    }
+
+    void Core::renderLoop() {
+        DVK_TRACE_THREAD_NAME("render");
+        // Frames sort their draws through the job system, which this thread drives from now on
+        jobSystem->attachThread();
+
+        try {
+            uint64_t handledRequests = 0;
+            bool frameDrawn = true;
+            while (!renderThreadStopping.load()) {
+                // A frame that ended in a swapchain recreation drew nothing, it is retried without a new request
+                if (options.onDemand && frameDrawn) {
+                    redrawRequests.wait(handledRequests);
+                    handledRequests = redrawRequests.load();
+                    if (renderThreadStopping.load()) {
+                        break;
+                    }
+                    // The idle time is not a pacing miss
+                    if (framePacer) {
+                        framePacer->reset();
+                    }
+                }
+
+                uint64_t previousFrame = frameNumber;
+                this->drawFrame();
+                frameDrawn = frameNumber != previousFrame;
+                if (frameDrawn) {
+                    window->addRenderedFrame();
+                }
+
+                if (benchmark && benchmark->isComplete()) {
+                    break;
+                }
+            }
+            getDeviceDispatch().vkDeviceWaitIdle(*(device->getDevice()));
+        } catch (...) {
+            renderThreadError = std::current_exception();
+        }
+
+        renderThreadFinished = true;
+        window->wakeUp();
     }
 
     void Core::init() {
+        StartupGraph& graph = *startupGraph;
+        const uint32_t none = StartupGraph::NO_STAGE;
+
+        // GLFW calls stay on this thread, the instance only queries its extensions meanwhile
+        if (!options.headless) {
+            Window::initGlfw();
+        }
+        uint32_t windowStage = options.headless ? none : graph.add("window", {}, [this] {
+            window = std::make_unique<Window>(options.width, options.height);
+            window->setPaced(options.targetFps != 0);
+        }, true);
+        uint32_t instanceStage = graph.add("instance", {}, [this] {
+            instance = std::make_unique<Instance>(options.headless);
+        });
+        uint32_t debugStage = graph.add("debug", {instanceStage}, [this] {
+            debug = std::make_unique<Debug>(instance->getInstance());
+        });
+        uint32_t surfaceStage = options.headless ? none : graph.add("surface", {windowStage, instanceStage}, [this] {
+            surface = std::make_unique<Surface>(window->getRawWindow(), instance->getInstance());
+        });
+        // After the messenger, so that validation covers device creation
+        uint32_t deviceStage = graph.add("device", {debugStage, surfaceStage}, [this] {
+            device = std::make_unique<Device>(instance->getInstance(), getSurface());
+        });
+        uint32_t bindlessStage = graph.add("bindlessDescriptors", {deviceStage}, [this] {
+            if (device->supportsBindlessDescriptors()) {
+                bindlessDescriptors = std::make_unique<BindlessDescriptors>(
+                        device->getPhysicalDevice(),
+                        device->getDevice(),
+                        MAX_FRAMES_IN_FLIGHT,
+                        DEFAULT_BINDLESS_SAMPLED_IMAGES,
+                        DEFAULT_BINDLESS_STORAGE_BUFFERS,
+                        DEFAULT_BINDLESS_SAMPLERS
+                        );
+            }
+        });
+        uint32_t uniformRingStage = graph.add("uniformRing", {deviceStage}, [this] {
+            uniformRing = std::make_unique<UniformRing>(
+                    device->getPhysicalDevice(),
+                    device->getDevice(),
+                    MAX_FRAMES_IN_FLIGHT,
+                    DEFAULT_UNIFORM_RING_SIZE,
+                    sizeof(DrawUniforms)
+                    );
+        });
+        uint32_t targetsStage = graph.add(options.headless ? "offscreenTargets" : "swapchain", {deviceStage, windowStage}, [this] {
+            if (options.headless) {
+                offscreenTargets = std::make_unique<OffscreenTargets>(
+                        device->getPhysicalDevice(),
+                        device->getDevice(),
+                        VkExtent2D{options.width, options.height},
+                        MAX_FRAMES_IN_FLIGHT,
+                        resourcePools.get()
+                        );
+            } else {
+                swapchain = std::make_unique<Swapchain>(
+                        window.get(),
+                        surface->getSurface(),
+                        device->getPhysicalDevice(),
+                        device->getDevice(),
+                        device->getQueueFamilyIndices()
+                        );
+            }
+        });
+        uint32_t imageViewsStage = graph.add("imageViews", {targetsStage}, [this] {
+            swapchainImageViews = std::make_unique<SwapchainImageViews>(
+                    device->getDevice(),
+                    getTargetImages(),
+                    getTargetImageFormat()
+                    );
+        });
+        // A swapchain's format is known from its surface, so with a window the render pass and the pipelines
+        // are built while the swapchain is created
+        uint32_t renderPassStage = graph.add("renderPass", {deviceStage, options.headless ? targetsStage : none}, [this] {
+            renderFormat = options.headless
+                    ? *offscreenTargets->getImageFormat()
+                    : Swapchain::chooseImageFormat(*device->getPhysicalDevice(), *surface->getSurface());
+            renderPass = std::make_unique<RenderPass>(
+                    device->getDevice(),
+                    &renderFormat,
+                    options.headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+                    );
+        });
+        uint32_t pipelineStage = graph.add("graphicsPipeline", {renderPassStage, bindlessStage, uniformRingStage}, [this] {
+            graphicsPipeline = std::make_unique<GraphicsPipeline>(
+                    device->getDevice(),
+                    renderPass->getRenderPass(),
+                    &pipelineExtent,
+                    resourcePools.get(),
+                    bindlessDescriptors.get(),
+                    uniformRing.get(),
+                    options.instances > 0
+                    );
+        });
+        uint32_t framebuffersStage = graph.add("framebuffers", {imageViewsStage, renderPassStage}, [this] {
+            if (*getTargetImageFormat() != renderFormat) {
+                throw std::runtime_error("The swapchain format differs from the one the render pass was created for!");
+            }
+            framebuffers = std::make_unique<Framebuffers>(
+                    device->getDevice(),
+                    swapchainImageViews->getSwapchainImageViews(),
+                    renderPass->getRenderPass(),
+                    getTargetExtent()
+                    );
+        });
+        uint32_t dynamicResolutionStage = options.resolutionBudget <= 0.0 ? none : graph.add("dynamicResolution", {framebuffersStage}, [this] {
+            dynamicResolution = createDynamicResolution();
+        });
+        // Both register buffers in the same pool and the vertices are uploaded through the graphics queue,
+        // so they share a stage, which overlaps the pipeline build
+        uint32_t buffersStage = graph.add("buffers", {deviceStage}, [this] {
+            vertexBuffer = std::make_unique<VertexBuffer>(
+                    device->getDevice(),
+                    device->getPhysicalDevice(),
+                    device->getGraphicsQueue(),
+                    device->getQueueFamilyIndices(),
+                    resourcePools.get()
+                    );
+            if (options.instances > 0 && !options.gpuDriven) {
+                instanceBuffer = std::make_unique<InstanceBuffer>(
+                        device->getPhysicalDevice(),
+                        device->getDevice(),
+                        options.instances,
+                        MAX_FRAMES_IN_FLIGHT,
+                        resourcePools.get()
+                        );
+            }
+        });
+        uint32_t gpuSceneStage = !options.gpuDriven ? none : graph.add("gpuScene", {buffersStage, pipelineStage}, [this] {
+            gpuScene = createGpuScene();
+        });
+        uint32_t computeSchedulerStage = !options.asyncCompute ? none : graph.add("computeScheduler", {deviceStage}, [this] {
+            computeScheduler = std::make_unique<ComputeScheduler>(
+                    device->getDevice(),
+                    device->getComputeQueue(),
+                    device->getQueueFamilyIndices()->getComputeFamilyValue(),
+                    MAX_FRAMES_IN_FLIGHT
+                    );
+        });
+        uint32_t gpuProfilerStage = graph.add("gpuProfiler", {deviceStage}, [this] {
+            gpuProfiler = std::make_unique<GpuProfiler>(
+                    device->getProfile(),
+                    device->getDevice(),
+                    device->getQueueFamilyIndices()->getGraphicsFamilyValue(),
+                    MAX_FRAMES_IN_FLIGHT
+                    );
+        });
+        uint32_t frameReadbackStage = options.captureDir.empty() ? none : graph.add("frameReadback", {targetsStage}, [this] {
+            if (swapchain && !(swapchain->getImageUsage() & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)) {
+                throw std::runtime_error("--capture-dir copies the swapchain images, this surface does not allow it!");
+            }
+            frameReadback = std::make_unique<FrameReadback>(
+                    device->getPhysicalDevice(),
+                    device->getDevice(),
+                    *getTargetImageFormat(),
+                    options.headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                    MAX_FRAMES_IN_FLIGHT
+                    );
+            frameCapture = std::make_unique<FrameCapture>(options.captureDir, FrameCapture::parseCaptureFormat(options.captureFormat));
+        });
+        graph.add("commandBuffers", {framebuffersStage, dynamicResolutionStage, pipelineStage, buffersStage, gpuSceneStage, computeSchedulerStage, gpuProfilerStage, frameReadbackStage}, [this] {
+            commandBuffers = std::make_unique<CommandBuffers>(
+                    device->getPhysicalDevice(),
+                    device->getDevice(),
+                    device->getQueueFamilyIndices(),
+                    framebuffers->getFramebuffers(),
+                    getTargetImages(),
+                    renderPass->getRenderPass(),
+                    getTargetExtent(),
+                    resourcePools.get(),
+                    renderQueue.get(),
+                    instanceBuffer.get(),
+                    gpuScene.get(),
+                    bindlessDescriptors.get(),
+                    uniformRing.get(),
+                    dynamicResolution.get(),
+                    gpuProfiler.get(),
+                    frameReadback.get(),
+                    frameArenas.get()
+                    );
+        });
+        graph.add("synchronization", {targetsStage}, [this] {
+            synchronization = std::make_unique<Synchronization>(
+                    device->getDevice(),
+                    getTargetImages(),
+                    device->getGraphicsQueue(),
+                    MAX_FRAMES_IN_FLIGHT
+                    );
+        });
+
+        graph.run(!options.serialStartup);
 
+        if (benchmark && getApiCallCounter().isEnabled()) {
+            ApiFrameCalls startupCalls;
+            getApiCallCounter().endFrame(startupCalls);
+            benchmark->setStartupApiCalls(startupCalls);
+        }
     }
 
     void Core::start() {
-        this->window->startLoop([this](){
-//            std::cout << "frame draw" << std::endl;
+        if (options.startupBenchmark) {
+            runStartupBenchmark();
+            return;
+        }
+
+        if (!options.metricsOutput.empty()) {
+            metricsExporter = std::make_unique<metrics::MetricsExporter>(metrics::getRegistry(), options.metricsOutput, std::chrono::seconds(1));
+        }
+
+        if (options.checkFrameAllocations) {
+            checkFrameAllocations();
+        } else if (options.headless) {
+            uint32_t frames = benchmark ? benchmark->getTotalFrames() : options.frames;
+            for (uint32_t i = 0; i < frames; i++) {
+                simulate(static_cast<double>(frameNumber) * HEADLESS_FRAME_TIME);
+                this->drawFrame();
+            }
+            getDeviceDispatch().vkDeviceWaitIdle(*(device->getDevice()));
+        } else {
+            // This thread handles events and simulates, the render thread draws whatever was published last,
+            // so a slow frame never delays input and a fence wait never stalls the event loop
+            auto simulationStart = Clock::now();
+            simulate(0.0);
+            std::thread renderThread(&Core::renderLoop, this);
+
+            this->window->startLoop([this, simulationStart](){
+                if (renderThreadFinished) {
+                    window->requestClose();
+                }
+                return handleEvents(std::chrono::duration<double>(Clock::now() - simulationStart).count());
+            }, true);
+
+            renderThreadStopping = true;
+            requestFrame();
+            renderThread.join();
+            jobSystem->attachThread();
+            if (renderThreadError) {
+                std::rethrow_exception(renderThreadError);
+            }
+        }
+
+        // The device is idle, the copies of the last frames are delivered without waiting for another frame
+        if (frameReadback) {
+            frameReadback->collectAll();
+        }
+
+        if (benchmark) {
+            writeBenchmarkReport();
+        }
+
+        if (metricsExporter) {
+            metricsExporter->stop();
+            exportMetrics();
+        }
+
+        if (!options.traceOutput.empty()) {
+            trace::writeChromeTrace(options.traceOutput);
+        }
+    }
+
+    void Core::writeBenchmarkReport() {
+        if (options.reportOutput.empty()) {
+            benchmark->writeReport(std::cout, reportFormat);
+            return;
+        }
+
+        std::ofstream file(options.reportOutput);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open benchmark report file: " + options.reportOutput);
+        }
+        benchmark->writeReport(file, reportFormat);
+    }
+
+    void Core::runStartupBenchmark() {
+        // Drawn on this thread without the render thread, a frame ending in a swapchain recreation is redrawn
+        simulate(0.0);
+        while (frameNumber == 0) {
             this->drawFrame();
-        }, true);
+        }
+        getDeviceDispatch().vkDeviceWaitIdle(*(device->getDevice()));
+        auto firstFrame = StartupGraph::Clock::now();
+
+        if (options.reportOutput.empty()) {
+            startupGraph->writeReport(std::cout, processStart, firstFrame);
+            return;
+        }
+
+        std::ofstream file(options.reportOutput);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open startup report file: " + options.reportOutput);
+        }
+        startupGraph->writeReport(file, processStart, firstFrame);
+    }
+
+    void Core::checkFrameAllocations() {
+        // With the job workers, which count from their start
+        memory::countThreadAllocations();
+
+        // Warm-up frames may allocate once, e.g. to register trace buffers or grow driver pools
+        for (uint32_t i = 0; i < options.warmupFrames; i++) {
+            simulate(static_cast<double>(frameNumber) * HEADLESS_FRAME_TIME);
+            this->drawFrame();
+        }
+
+        uint64_t allocations = 0;
+        uint32_t allocatingFrames = 0;
+        for (uint32_t i = 0; i < options.frames; i++) {
+            simulate(static_cast<double>(frameNumber) * HEADLESS_FRAME_TIME);
+            // Also counts the jobs drawFrame runs on the workers
+            uint64_t before = memory::getAllocationCount();
+            this->drawFrame();
+            uint64_t frameAllocations = memory::getAllocationCount() - before;
+
+            allocations += frameAllocations;
+            allocatingFrames += frameAllocations != 0 ? 1 : 0;
+        }
+        getDeviceDispatch().vkDeviceWaitIdle(*(device->getDevice()));
+
+        std::cout << "drawFrame heap allocations: " << allocations << " in " << allocatingFrames << " of "
+                  << options.frames << " steady-state frames" << std::endl;
+        if (allocations != 0) {
+            throw std::runtime_error("drawFrame allocated on the heap in steady state!");
+        }
+    }
+
+    void Core::exportMetrics() {
+        metrics::getRegistry().writePrometheusFile(options.metricsOutput);
     }
 
     void Core::recreateSwapchain() {
-        auto start = std::chrono::high_resolution_clock::now();
+        DVK_TRACE_ZONE("recreateSwapchain");
+        auto start = Clock::now();
 
-        int width = 0, height = 0;
-        glfwGetFramebufferSize(window->getRawWindow(), &width, &height);
+        // Minimized. Events are handled by the event loop, this thread only watches the size it records.
+        uint32_t width = 0, height = 0;
+        window->getFramebufferSize(width, height);
         while (width == 0 || height == 0) {
-            glfwGetFramebufferSize(window->getRawWindow(), &width, &height);
-            glfwWaitEvents();
+            if (renderThreadStopping) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            window->getFramebufferSize(width, height);
         }
 
-        vkDeviceWaitIdle(*(device->getDevice()));
+        getDeviceDispatch().vkDeviceWaitIdle(*(device->getDevice()));
 
-        commandBuffers.reset();
         framebuffers.reset();
         swapchainImageViews.reset();
         swapchain.reset();
 
         swapchain = std::make_unique<Swapchain>(
-                window->getRawWindow(),
+                window.get(),
                 surface->getSurface(),
                 device->getPhysicalDevice(),
-                device->getDevice()
+                device->getDevice(),
+                device->getQueueFamilyIndices()
                 );
         swapchainImageViews = std::make_unique<SwapchainImageViews>(
                 device->getDevice(),
@@ -187,21 +808,14 @@ namespace dvk::Core {
                 renderPass->getRenderPass(),
                 swapchain->getSwapchainExtent()
                 );
-        commandBuffers = std::make_unique<CommandBuffers>(
-                device->getPhysicalDevice(),
-                device->getDevice(),
-                surface->getSurface(),
-                framebuffers->getFramebuffers(),
-                renderPass->getRenderPass(),
-                swapchain->getSwapchainExtent(),
-                graphicsPipeline->getGraphicsPipeline(),
-                vertexBuffer->getVertexBuffer(),
-                vertexBuffer->getVertices()
-                );
+        // Pipeline and mesh are referenced by handle, only the render targets changed
+        commandBuffers->setRenderTargets(framebuffers->getFramebuffers(), swapchain->getSwapchainImages(), swapchain->getSwapchainExtent());
+        if (dynamicResolution) {
+            dynamicResolution->setTargets(swapchain->getSwapchainImages(), *swapchain->getSwapchainExtent());
+        }
 
-        auto end = std::chrono::high_resolution_clock::now();
-        auto time_taken = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-        std::cout << "Swapchain recreated - time taken: " << time_taken << " " << "milliseconds" << std::endl;
+        rendererMetrics->swapchainRecreations.add();
+        rendererMetrics->swapchainRecreationSeconds.observe(std::chrono::duration<double>(Clock::now() - start).count());
     }
 
 } // dvk
\ No newline at end of file
@@ -4,6 +4,8 @@
 
 #include "Debug.hpp"
 #include "Constants.hpp"
+#include "DebugMessageSink.hpp"
+#include "HostAllocator.hpp"
 
 namespace dvk {
 
@@ -53,10 +55,8 @@ namespace dvk {
             const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
             void* pUserData)
     {
-        if (messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT)
-        {
-            std::cerr << "\nValidation Layer: " << pCallbackData->pMessage << std::endl;
-        }
+        // Called on driver threads, including the frame loop's, the sink only copies the message into its queue
+        getDebugMessageSink().push(messageSeverity, messageType, pCallbackData);
         return VK_FALSE;
     }
 
@@ -66,8 +66,8 @@ namespace dvk {
 
         createInfo = {};
         createInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
-        createInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT
-                                     | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+        // Only what the sink keeps, the layer does not format the messages it would filter out
+        createInfo.messageSeverity = getDebugMessageSink().getSubscribedSeverities();
         createInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT
                                  | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
         createInfo.pfnUserCallback = debugCallback;
@@ -79,7 +79,7 @@ namespace dvk {
         auto func = (PFN_vkCreateDebugUtilsMessengerEXT) vkGetInstanceProcAddr(*instance, "vkCreateDebugUtilsMessengerEXT");
         if (func != nullptr)
         {
-            return func(*instance, &createInfo, nullptr, &debugMessenger);
+            return func(*instance, &createInfo, memory::getAllocationCallbacks(), &debugMessenger);
         }
         else
         {
@@ -92,7 +92,7 @@ namespace dvk {
         auto func = (PFN_vkDestroyDebugUtilsMessengerEXT) vkGetInstanceProcAddr(*instance, "vkDestroyDebugUtilsMessengerEXT");
         if (func != nullptr)
         {
-            func(*instance, debugMessenger, nullptr);
+            func(*instance, debugMessenger, memory::getAllocationCallbacks());
         }
     }
 
@@ -108,16 +108,30 @@ namespace dvk {
 
     Debug::Debug(VkInstance* instance) : instance(instance){
 
-        if (constants::enable_Validation_Layers && !checkValidationLayerSupport())
+        if (!constants::enable_Validation_Layers)
+        {
+            return;
+        }
+
+        if (!checkValidationLayerSupport())
         {
             throw std::runtime_error("\nValidation layer requested but not available.");
         }
 
+        // Also writes what the instance creation's messenger pushed
+        getDebugMessageSink().start();
         setupDebugMessenger();
     }
 
     Debug::~Debug() {
-        destroyDebugUtilsMessengerEXT(instance);
+        if (debugMessenger != VK_NULL_HANDLE)
+        {
+            destroyDebugUtilsMessengerEXT(instance);
+
+            DebugMessageSink& sink = getDebugMessageSink();
+            sink.flush();
+            sink.writeSummary(std::cerr);
+        }
     }
 
     const std::vector<const char *> &Debug::getValidationLayers() {
@@ -0,0 +1,313 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+#include "DebugMessageSink.hpp"
+#include "Trace.hpp"
+
+namespace dvk {
+
+    // Distinct texts remembered per message ID, past it every new text of the ID is treated as distinct
+    static constexpr size_t MAX_REMEMBERED_TEXTS = 64;
+    // Length of a message quoted in the summary
+    static constexpr size_t SUMMARY_TEXT_LENGTH = 160;
+
+    static void copyString(char* destination, size_t size, const char* source)
+    {
+        if (source == nullptr)
+        {
+            destination[0] = '\0';
+            return;
+        }
+
+        size_t length = strnlen(source, size - 1);
+        std::memcpy(destination, source, length);
+        destination[length] = '\0';
+    }
+
+    static const char* getSeverityName(VkDebugUtilsMessageSeverityFlagBitsEXT severity)
+    {
+        switch (severity)
+        {
+            case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT:
+                return "error";
+            case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT:
+                return "warning";
+            case VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT:
+                return "info";
+            default:
+                return "verbose";
+        }
+    }
+
+    static const char* getTypeName(VkDebugUtilsMessageTypeFlagsEXT type)
+    {
+        if (type & VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT)
+        {
+            return "performance";
+        }
+        if (type & VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT)
+        {
+            return "validation";
+        }
+        return "general";
+    }
+
+    DebugMessageSink::~DebugMessageSink()
+    {
+        stop();
+    }
+
+    void DebugMessageSink::start()
+    {
+        if (drainThread.joinable())
+        {
+            return;
+        }
+
+        stopping = false;
+        drainThread = std::thread(&DebugMessageSink::drainLoop, this);
+    }
+
+    void DebugMessageSink::stop()
+    {
+        if (!drainThread.joinable())
+        {
+            return;
+        }
+
+        stopping = true;
+        pushes.fetch_add(1);
+        pushes.notify_one();
+        drainThread.join();
+    }
+
+    bool DebugMessageSink::push(
+            VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+            VkDebugUtilsMessageTypeFlagsEXT type,
+            const VkDebugUtilsMessengerCallbackDataEXT* callbackData)
+    {
+        if (severity < minSeverity.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        auto time = std::chrono::steady_clock::now();
+        bool pushed = queue.push([&](DebugMessage& message) {
+            message.severity = severity;
+            message.type = type;
+            message.idNumber = callbackData->messageIdNumber;
+            message.time = time;
+            copyString(message.idName, DEBUG_MESSAGE_ID_SIZE, callbackData->pMessageIdName);
+            copyString(message.text, DEBUG_MESSAGE_TEXT_SIZE, callbackData->pMessage);
+        });
+
+        if (!pushed)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        received.fetch_add(1);
+        pushes.fetch_add(1);
+        pushes.notify_one();
+        return true;
+    }
+
+    void DebugMessageSink::flush()
+    {
+        if (!drainThread.joinable())
+        {
+            return;
+        }
+
+        uint64_t target = received.load();
+        uint64_t done = processed.load();
+        while (done < target)
+        {
+            processed.wait(done);
+            done = processed.load();
+        }
+    }
+
+    void DebugMessageSink::drainLoop()
+    {
+        DVK_TRACE_THREAD_NAME("debug messages");
+
+        for (;;)
+        {
+            // Read before draining, a push after the queue was found empty changes it and the wait returns
+            uint32_t seenPushes = pushes.load();
+
+            uint64_t count = 0;
+            {
+                std::lock_guard<std::mutex> lock(statsMutex);
+                while (queue.pop([this](const DebugMessage& message) { process(message); }))
+                {
+                    count++;
+                }
+            }
+
+            if (count > 0)
+            {
+                std::cerr.flush();
+                processed.fetch_add(count);
+                processed.notify_all();
+                continue;
+            }
+
+            if (stopping.load())
+            {
+                break;
+            }
+            pushes.wait(seenPushes);
+        }
+    }
+
+    void DebugMessageSink::process(const DebugMessage& message)
+    {
+        std::string key = std::string(message.idName) + "#" + std::to_string(message.idNumber);
+        MessageStats& entry = stats[key];
+        if (entry.count++ == 0)
+        {
+            entry.severity = message.severity;
+            entry.type = message.type;
+            entry.name = message.idName[0] != '\0' ? message.idName : "(no id)";
+            entry.firstText = message.text;
+        }
+
+        size_t textHash = std::hash<std::string_view>{}(message.text);
+        if (entry.printedTexts.count(textHash) != 0)
+        {
+            entry.duplicates++;
+            return;
+        }
+
+        uint32_t limit = rateLimit.load(std::memory_order_relaxed);
+        if (message.time - entry.windowStart >= std::chrono::seconds(1))
+        {
+            entry.windowStart = message.time;
+            entry.printedInWindow = 0;
+        }
+        if (limit != 0 && entry.printedInWindow >= limit)
+        {
+            entry.suppressed++;
+            entry.pendingSuppressed++;
+            return;
+        }
+
+        entry.printedInWindow++;
+        entry.printed++;
+        if (entry.printedTexts.size() < MAX_REMEMBERED_TEXTS)
+        {
+            entry.printedTexts.insert(textHash);
+        }
+
+        std::cerr << "\nValidation Layer [" << getSeverityName(message.severity) << ", " << getTypeName(message.type) << "] "
+                  << message.text;
+        if (entry.pendingSuppressed > 0)
+        {
+            std::cerr << " (" << entry.pendingSuppressed << " more of this ID suppressed)";
+            entry.pendingSuppressed = 0;
+        }
+        std::cerr << '\n';
+    }
+
+    void DebugMessageSink::setMinSeverity(VkDebugUtilsMessageSeverityFlagBitsEXT severity) {
+        minSeverity = severity;
+    }
+
+    VkDebugUtilsMessageSeverityFlagsEXT DebugMessageSink::getSubscribedSeverities() const
+    {
+        const VkDebugUtilsMessageSeverityFlagBitsEXT severities[] = {
+                VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT,
+                VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT,
+                VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT,
+                VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT
+        };
+
+        VkDebugUtilsMessageSeverityFlagsEXT flags = 0;
+        for (auto severity : severities)
+        {
+            if (severity >= minSeverity.load())
+            {
+                flags |= severity;
+            }
+        }
+        return flags;
+    }
+
+    void DebugMessageSink::setRateLimit(uint32_t messagesPerSecond) {
+        rateLimit = messagesPerSecond;
+    }
+
+    VkDebugUtilsMessageSeverityFlagBitsEXT DebugMessageSink::parseSeverity(const std::string& name)
+    {
+        if (name == "verbose")
+        {
+            return VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT;
+        }
+        if (name == "info")
+        {
+            return VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
+        }
+        if (name == "warning")
+        {
+            return VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT;
+        }
+        if (name == "error")
+        {
+            return VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+        }
+        throw std::runtime_error("Unknown debug message severity: " + name + ", expected verbose, info, warning or error");
+    }
+
+    void DebugMessageSink::writeSummary(std::ostream& out, uint32_t topCount) const
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+
+        uint64_t printed = 0, duplicates = 0, suppressed = 0;
+        std::vector<const MessageStats*> performance;
+        for (const auto& [key, entry] : stats)
+        {
+            printed += entry.printed;
+            duplicates += entry.duplicates;
+            suppressed += entry.suppressed;
+            if (entry.type & VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT)
+            {
+                performance.push_back(&entry);
+            }
+        }
+
+        out << "Debug messages: " << received.load() << " received, " << printed << " printed, " << duplicates
+            << " duplicates, " << suppressed << " rate limited, " << dropped.load() << " dropped (queue full)\n";
+        if (performance.empty())
+        {
+            return;
+        }
+
+        std::sort(performance.begin(), performance.end(), [](const MessageStats* a, const MessageStats* b) {
+            return a->count > b->count;
+        });
+        size_t shown = std::min<size_t>(performance.size(), topCount);
+        out << "Top performance warnings (" << shown << " of " << performance.size() << " IDs):\n";
+        for (size_t i = 0; i < shown; i++)
+        {
+            const MessageStats& entry = *performance[i];
+            out << "  " << entry.count << "x " << entry.name << ": " << entry.firstText.substr(0, SUMMARY_TEXT_LENGTH)
+                << (entry.firstText.size() > SUMMARY_TEXT_LENGTH ? "...\n" : "\n");
+        }
+    }
+
+    DebugMessageSink& getDebugMessageSink() {
+        static DebugMessageSink sink;
+        return sink;
+    }
+
+} // dvk
@@ -2,35 +2,70 @@
 // Created by Arouay on 31/03/2023.
 //
 
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <string>
 #include "Device.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
 
 namespace dvk {
     Device::Device(VkInstance* instance, VkSurfaceKHR* surface) :
         instance(instance),
         surface(surface)
     {
+        // Without a surface nothing is presented, so the swapchain extension is not needed
+        if (*surface != VK_NULL_HANDLE)
+        {
+            extensions = utils::deviceExtensions;
+        }
+
         pickPhysicalDevice();
         createLogicalDevice();
     }
 
     Device::~Device() {
-        vkDestroyDevice(device, nullptr);
+        getDeviceDispatch().vkDestroyDevice(device, memory::getAllocationCallbacks());
     }
 
-    bool Device::isDeviceSuitable(VkPhysicalDevice device)
+    const DeviceProfile* Device::findRequestedDevice(const std::vector<DeviceProfile>& profiles, const std::string& request)
     {
-        QueueFamilyIndices indices(&device, surface);
-        bool deviceExtensionsSupported = utils::checkDeviceExensionsSupport(device);
-
-        bool swapChainAdequate = false;
-        if (deviceExtensionsSupported)
+        const DeviceProfile* requested = nullptr;
+        if (std::all_of(request.begin(), request.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); }))
         {
-            SwapchainSupportDetails	swapChainSupport;
-            swapChainSupport.querySwapChainSupportDetails(device, *surface);
-            swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
+            size_t index = std::stoul(request);
+            if (index < profiles.size())
+            {
+                requested = &profiles[index];
+            }
+        }
+        else
+        {
+            auto lower = [](std::string text) {
+                std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+                return text;
+            };
+            std::string name = lower(request);
+            for (const auto& profile : profiles)
+            {
+                if (lower(profile.getName()).find(name) != std::string::npos)
+                {
+                    requested = &profile;
+                    break;
+                }
+            }
         }
 
-        return indices.isComplete() && deviceExtensionsSupported && swapChainAdequate;
+        if (requested == nullptr)
+        {
+            throw std::runtime_error("DVK_DEVICE=" + request + " matches no vulkan device!");
+        }
+        if (!requested->isSuitable())
+        {
+            throw std::runtime_error("DVK_DEVICE=" + request + " selects " + requested->getName() + ", which cannot run the renderer!");
+        }
+        return requested;
     }
 
     void Device::pickPhysicalDevice()
@@ -46,27 +81,47 @@ namespace dvk {
         std::vector<VkPhysicalDevice> devices(deviceCount);
         vkEnumeratePhysicalDevices(*instance, &deviceCount, devices.data());
 
+        std::vector<DeviceProfile> profiles;
+        profiles.reserve(deviceCount);
         for (const auto& device : devices)
         {
-            if (isDeviceSuitable(device))
+            profiles.emplace_back(device, *surface, extensions);
+        }
+
+        // DVK_DEVICE forces a device, by its enumeration index or a part of its name
+        const DeviceProfile* picked = nullptr;
+        const char* request = std::getenv("DVK_DEVICE");
+        if (request != nullptr && *request != '\0')
+        {
+            picked = findRequestedDevice(profiles, request);
+        }
+        else
+        {
+            // The first of the best scored, enumeration order breaks ties
+            for (const auto& candidate : profiles)
             {
-                physicalDevice = device;
-//			break;
+                if (candidate.isSuitable() && (picked == nullptr || candidate.getScore() > picked->getScore()))
+                {
+                    picked = &candidate;
+                }
             }
         }
 
-        if (physicalDevice == VK_NULL_HANDLE)
+        if (picked == nullptr)
         {
             throw std::runtime_error("Unable to find suitable GPU!");
         }
+
+        profile = std::make_unique<DeviceProfile>(*picked);
+        physicalDevice = profile->getPhysicalDevice();
     }
 
     void Device::createLogicalDevice()
     {
-        QueueFamilyIndices indices(&physicalDevice, surface);
+        const QueueFamilyIndices& indices = *profile->getQueueFamilyIndices();
 
         std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-        std::set<uint32_t> uniqueQueueFamilies = { indices.getGraphicsFamilyValue(), indices.getPresentationFamilyValue() };
+        std::set<uint32_t> uniqueQueueFamilies = { indices.getGraphicsFamilyValue(), indices.getPresentationFamilyValue(), indices.getComputeFamilyValue() };
 
         float queuePriority = 1.0f;
         for (uint32_t familyQueue : uniqueQueueFamilies)
@@ -79,15 +134,45 @@ namespace dvk {
             queueCreateInfos.push_back(queueCreateInfo);
         }
 
+        // Optional features are enabled when supported, the paths needing them check support before running
+        bool vulkan12 = profile->getProperties()->apiVersion >= VK_API_VERSION_1_2;
+        bool vulkan13 = profile->getProperties()->apiVersion >= VK_API_VERSION_1_3;
+        const VkPhysicalDeviceFeatures& supportedFeatures = *profile->getFeatures();
+        const VkPhysicalDeviceVulkan12Features& supportedFeatures12 = *profile->getFeatures12();
+        const VkPhysicalDeviceVulkan13Features& supportedFeatures13 = *profile->getFeatures13();
+
         VkPhysicalDeviceFeatures deviceFeatures{};
+        deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+        deviceFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
+
+        VkPhysicalDeviceVulkan13Features deviceFeatures13{};
+        deviceFeatures13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+        deviceFeatures13.synchronization2 = supportedFeatures13.synchronization2;
+
+        VkPhysicalDeviceVulkan12Features deviceFeatures12{};
+        deviceFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        deviceFeatures12.pNext = vulkan13 ? &deviceFeatures13 : nullptr;
+        deviceFeatures12.drawIndirectCount = supportedFeatures12.drawIndirectCount;
+        deviceFeatures12.descriptorIndexing = supportedFeatures12.descriptorIndexing;
+        deviceFeatures12.runtimeDescriptorArray = supportedFeatures12.runtimeDescriptorArray;
+        deviceFeatures12.descriptorBindingPartiallyBound = supportedFeatures12.descriptorBindingPartiallyBound;
+        deviceFeatures12.descriptorBindingUpdateUnusedWhilePending = supportedFeatures12.descriptorBindingUpdateUnusedWhilePending;
+        deviceFeatures12.descriptorBindingSampledImageUpdateAfterBind = supportedFeatures12.descriptorBindingSampledImageUpdateAfterBind;
+        deviceFeatures12.descriptorBindingStorageBufferUpdateAfterBind = supportedFeatures12.descriptorBindingStorageBufferUpdateAfterBind;
+        deviceFeatures12.shaderSampledImageArrayNonUniformIndexing = supportedFeatures12.shaderSampledImageArrayNonUniformIndexing;
+        deviceFeatures12.shaderStorageBufferArrayNonUniformIndexing = supportedFeatures12.shaderStorageBufferArrayNonUniformIndexing;
+        // Lets the GPU profiler reset its queries on the host rather than in every frame's command buffer
+        deviceFeatures12.hostQueryReset = supportedFeatures12.hostQueryReset;
+        deviceFeatures12.timelineSemaphore = supportedFeatures12.timelineSemaphore;
 
         VkDeviceCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        createInfo.pNext = vulkan12 ? &deviceFeatures12 : nullptr;
         createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
         createInfo.pQueueCreateInfos = queueCreateInfos.data();
         createInfo.pEnabledFeatures = &deviceFeatures;
-        createInfo.enabledExtensionCount = static_cast<uint32_t>(utils::deviceExtensions.size());
-        createInfo.ppEnabledExtensionNames = utils::deviceExtensions.data();
+        createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+        createInfo.ppEnabledExtensionNames = extensions.data();
 
         if (constants::enable_Validation_Layers)
         {
@@ -98,13 +183,15 @@ namespace dvk {
             createInfo.enabledLayerCount = 0;
         }
 
-        if (vkCreateDevice(physicalDevice, &createInfo, nullptr, &device) != VK_SUCCESS)
+        if (vkCreateDevice(physicalDevice, &createInfo, memory::getAllocationCallbacks(), &device) != VK_SUCCESS)
         {
             throw std::runtime_error("Failed to create logical device!");
         }
+        loadDeviceDispatch(device);
 
-        vkGetDeviceQueue(device, indices.getGraphicsFamilyValue(), 0, &graphicsQueue);
-        vkGetDeviceQueue(device, indices.getPresentationFamilyValue(), 0, &presentationQueue);
+        getDeviceDispatch().vkGetDeviceQueue(device, indices.getGraphicsFamilyValue(), 0, &graphicsQueue);
+        getDeviceDispatch().vkGetDeviceQueue(device, indices.getPresentationFamilyValue(), 0, &presentationQueue);
+        getDeviceDispatch().vkGetDeviceQueue(device, indices.getComputeFamilyValue(), 0, &computeQueue);
     }
 
     VkPhysicalDevice *Device::getPhysicalDevice() {
@@ -122,4 +209,28 @@ namespace dvk {
     VkQueue *Device::getPresentationQueue() {
         return &presentationQueue;
     }
+
+    VkQueue *Device::getComputeQueue() {
+        return &computeQueue;
+    }
+
+    const DeviceProfile* Device::getProfile() const {
+        return profile.get();
+    }
+
+    const QueueFamilyIndices* Device::getQueueFamilyIndices() const {
+        return profile->getQueueFamilyIndices();
+    }
+
+    bool Device::supportsGpuDrivenRendering() const {
+        return profile->supportsGpuDrivenRendering();
+    }
+
+    bool Device::supportsBindlessDescriptors() const {
+        return profile->supportsBindlessDescriptors();
+    }
+
+    bool Device::supportsHostQueryReset() const {
+        return profile->supportsHostQueryReset();
+    }
 } // dvk
\ No newline at end of file
@@ -0,0 +1,71 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <chrono>
+#include "DeviceDispatch.hpp"
+
+namespace dvk {
+
+    static DeviceDispatch dispatch;
+
+    template<ApiCall call, typename Function>
+    struct CountedCall;
+
+    template<ApiCall call, typename Result, typename... Args>
+    struct CountedCall<call, Result (VKAPI_PTR*)(Args...)> {
+        using Function = Result (VKAPI_PTR*)(Args...);
+
+        // The driver's function, set by loadDeviceDispatch before the wrapper is installed
+        static inline Function function = nullptr;
+
+        struct Timer {
+            std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+            ~Timer() {
+                auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+                getApiCallCounter().record(call, static_cast<uint64_t>(elapsed.count()));
+            }
+        };
+
+        static Result VKAPI_PTR invoke(Args... args)
+        {
+            if constexpr (isApiCallTimed(call))
+            {
+                Timer timer;
+                return function(args...);
+            }
+            else
+            {
+                getApiCallCounter().count(call);
+                return function(args...);
+            }
+        }
+    };
+
+    void loadDeviceDispatch(VkDevice device)
+    {
+        DeviceDispatch driver;
+#define DVK_LOAD_ENTRY_POINT(name, timed) driver.name = reinterpret_cast<PFN_##name>(vkGetDeviceProcAddr(device, #name));
+        DVK_DEVICE_ENTRY_POINTS(DVK_LOAD_ENTRY_POINT)
+#undef DVK_LOAD_ENTRY_POINT
+
+        if (!getApiCallCounter().isEnabled())
+        {
+            dispatch = driver;
+            return;
+        }
+
+        // A missing entry point stays null rather than pointing at a wrapper with nothing to forward to
+#define DVK_WRAP_ENTRY_POINT(name, timed) \
+        CountedCall<ApiCall::name, PFN_##name>::function = driver.name; \
+        dispatch.name = driver.name != nullptr ? &CountedCall<ApiCall::name, PFN_##name>::invoke : nullptr;
+        DVK_DEVICE_ENTRY_POINTS(DVK_WRAP_ENTRY_POINT)
+#undef DVK_WRAP_ENTRY_POINT
+    }
+
+    const DeviceDispatch& getDeviceDispatch() {
+        return dispatch;
+    }
+
+} // dvk
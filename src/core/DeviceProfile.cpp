@@ -0,0 +1,209 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <algorithm>
+#include "DeviceProfile.hpp"
+#include "SwapchainSupportDetails.hpp"
+#include "ExtentionsUtils.hpp"
+
+namespace dvk {
+
+    // Any discrete GPU outranks any integrated one and so on, whatever else they support
+    static constexpr int64_t DISCRETE_GPU_SCORE = 100000;
+    static constexpr int64_t INTEGRATED_GPU_SCORE = 50000;
+    static constexpr int64_t VIRTUAL_GPU_SCORE = 20000;
+    static constexpr int64_t CPU_SCORE = 1000;
+    // Per GiB of device local memory, up to a cap so that memory never outweighs the device type
+    static constexpr int64_t LOCAL_MEMORY_GIB_SCORE = 100;
+    static constexpr int64_t MAX_LOCAL_MEMORY_GIB = 64;
+    static constexpr int64_t OPTIONAL_FEATURE_SCORE = 500;
+    static constexpr int64_t DEDICATED_COMPUTE_SCORE = 250;
+
+    DeviceProfile::DeviceProfile(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface, const std::vector<const char*>& extensions) :
+        physicalDevice(physicalDevice)
+    {
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+        queryFeatures();
+        queryQueueFamilies(surface);
+
+        extensionsSupported = utils::checkDeviceExensionsSupport(physicalDevice, extensions);
+        swapchainAdequate = surface == VK_NULL_HANDLE;
+        if (extensionsSupported && !swapchainAdequate)
+        {
+            SwapchainSupportDetails swapChainSupport;
+            swapChainSupport.querySwapChainSupportDetails(physicalDevice, surface);
+            swapchainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
+        }
+
+        for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++)
+        {
+            if (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+            {
+                deviceLocalBytes += memoryProperties.memoryHeaps[i].size;
+            }
+        }
+
+        computeScore();
+    }
+
+    void DeviceProfile::queryFeatures()
+    {
+        bool vulkan12 = properties.apiVersion >= VK_API_VERSION_1_2;
+        bool vulkan13 = properties.apiVersion >= VK_API_VERSION_1_3;
+
+        features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        features13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+        features12.pNext = vulkan13 ? &features13 : nullptr;
+
+        VkPhysicalDeviceFeatures2 features2{};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = vulkan12 ? &features12 : nullptr;
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+
+        // The profile is copied around, the chain would point into the original
+        features = features2.features;
+        features12.pNext = nullptr;
+    }
+
+    void DeviceProfile::queryQueueFamilies(VkSurfaceKHR surface)
+    {
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+
+        queueFamilies.resize(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+        presentationSupport.resize(queueFamilyCount, VK_FALSE);
+        for (uint32_t i = 0; i < queueFamilyCount; i++)
+        {
+            if (surface == VK_NULL_HANDLE)
+            {
+                // Headless: nothing is presented, the graphics family stands in for presentation
+                presentationSupport[i] = (queueFamilies[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) ? VK_TRUE : VK_FALSE;
+            }
+            else
+            {
+                vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentationSupport[i]);
+            }
+        }
+
+        queueFamilyIndices = QueueFamilyIndices(queueFamilies, presentationSupport);
+    }
+
+    void DeviceProfile::computeScore()
+    {
+        switch (properties.deviceType)
+        {
+            case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+                score = DISCRETE_GPU_SCORE;
+                break;
+            case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+                score = INTEGRATED_GPU_SCORE;
+                break;
+            case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+                score = VIRTUAL_GPU_SCORE;
+                break;
+            case VK_PHYSICAL_DEVICE_TYPE_CPU:
+                score = CPU_SCORE;
+                break;
+            default:
+                score = 0;
+                break;
+        }
+
+        auto localGib = static_cast<int64_t>(deviceLocalBytes >> 30);
+        score += std::min(localGib, MAX_LOCAL_MEMORY_GIB) * LOCAL_MEMORY_GIB_SCORE;
+
+        bool optionalFeatures[] = {
+                supportsGpuDrivenRendering(),
+                supportsBindlessDescriptors(),
+                supportsHostQueryReset(),
+                supportsTimelineSemaphores(),
+                supportsSynchronization2()
+        };
+        score += OPTIONAL_FEATURE_SCORE * std::count(std::begin(optionalFeatures), std::end(optionalFeatures), true);
+
+        if (queueFamilyIndices.isComplete() && queueFamilyIndices.hasDedicatedComputeFamily())
+        {
+            score += DEDICATED_COMPUTE_SCORE;
+        }
+    }
+
+    bool DeviceProfile::isSuitable() const {
+        return queueFamilyIndices.isComplete() && extensionsSupported && swapchainAdequate;
+    }
+
+    int64_t DeviceProfile::getScore() const {
+        return score;
+    }
+
+    const char* DeviceProfile::getName() const {
+        return properties.deviceName;
+    }
+
+    VkDeviceSize DeviceProfile::getDeviceLocalBytes() const {
+        return deviceLocalBytes;
+    }
+
+    VkPhysicalDevice DeviceProfile::getPhysicalDevice() const {
+        return physicalDevice;
+    }
+
+    const VkPhysicalDeviceProperties* DeviceProfile::getProperties() const {
+        return &properties;
+    }
+
+    const VkPhysicalDeviceMemoryProperties* DeviceProfile::getMemoryProperties() const {
+        return &memoryProperties;
+    }
+
+    const VkPhysicalDeviceFeatures* DeviceProfile::getFeatures() const {
+        return &features;
+    }
+
+    const VkPhysicalDeviceVulkan12Features* DeviceProfile::getFeatures12() const {
+        return &features12;
+    }
+
+    const VkPhysicalDeviceVulkan13Features* DeviceProfile::getFeatures13() const {
+        return &features13;
+    }
+
+    const std::vector<VkQueueFamilyProperties>* DeviceProfile::getQueueFamilies() const {
+        return &queueFamilies;
+    }
+
+    const QueueFamilyIndices* DeviceProfile::getQueueFamilyIndices() const {
+        return &queueFamilyIndices;
+    }
+
+    bool DeviceProfile::supportsGpuDrivenRendering() const {
+        return features12.drawIndirectCount && features.multiDrawIndirect && features.drawIndirectFirstInstance;
+    }
+
+    bool DeviceProfile::supportsBindlessDescriptors() const {
+        return features12.descriptorIndexing
+                && features12.runtimeDescriptorArray
+                && features12.descriptorBindingPartiallyBound
+                && features12.descriptorBindingUpdateUnusedWhilePending
+                && features12.descriptorBindingSampledImageUpdateAfterBind
+                && features12.descriptorBindingStorageBufferUpdateAfterBind
+                && features12.shaderSampledImageArrayNonUniformIndexing
+                && features12.shaderStorageBufferArrayNonUniformIndexing;
+    }
+
+    bool DeviceProfile::supportsHostQueryReset() const {
+        return features12.hostQueryReset;
+    }
+
+    bool DeviceProfile::supportsTimelineSemaphores() const {
+        return features12.timelineSemaphore;
+    }
+
+    bool DeviceProfile::supportsSynchronization2() const {
+        return features13.synchronization2;
+    }
+
+} // dvk
@@ -0,0 +1,216 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "DynamicResolution.hpp"
+#include "Metrics.hpp"
+#include "DeviceDispatch.hpp"
+
+namespace dvk {
+
+    // GPU time within this fraction of the budget leaves the scale alone, so that timing noise does not make the
+    // image pulse
+    static constexpr double SCALE_DEAD_BAND = 0.05;
+    // Fraction of the way to the scale that would exactly hit the budget taken per frame, the timings are a few
+    // frames late and a full step would overshoot
+    static constexpr double SCALE_GAIN = 0.25;
+    // Render extents are multiples of this many pixels, for tile friendly sizes and fewer distinct extents
+    static constexpr uint32_t EXTENT_GRANULARITY = 8;
+
+    DynamicResolution::DynamicResolution(
+            VkPhysicalDevice* physicalDevice,
+            VkDevice* device,
+            VkFormat* targetFormat,
+            std::vector<VkImage>* targetImages,
+            VkExtent2D targetExtent,
+            VkImageLayout targetFinalLayout,
+            uint32_t framesInFlight,
+            double budgetMilliseconds,
+            double minScale,
+            ResourcePools* resourcePools
+            ) :
+            physicalDevice(physicalDevice),
+            device(device),
+            targetFormat(targetFormat),
+            targetImages(targetImages),
+            targetExtent(targetExtent),
+            targetFinalLayout(targetFinalLayout),
+            framesInFlight(framesInFlight),
+            resourcePools(resourcePools),
+            budgetMilliseconds(budgetMilliseconds),
+            minScale(minScale),
+            frameScales(framesInFlight, 1.0),
+            frameExtents(framesInFlight, targetExtent)
+    {
+        if (budgetMilliseconds <= 0.0 || minScale <= 0.0 || minScale > 1.0)
+        {
+            throw std::runtime_error("Dynamic resolution needs a positive budget and a minimum scale in (0, 1]!");
+        }
+
+        checkFormatSupport();
+        // Same format as the output, so the scene pass stays compatible with the pipelines built for the output's pass
+        renderPass = std::make_unique<RenderPass>(device, targetFormat, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+        createSceneTargets();
+        metrics::getRendererMetrics().resolutionScale.set(scale);
+    }
+
+    void DynamicResolution::checkFormatSupport()
+    {
+        VkFormatProperties formatProperties;
+        vkGetPhysicalDeviceFormatProperties(*physicalDevice, *targetFormat, &formatProperties);
+
+        const VkFormatFeatureFlags requiredFeatures = VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT
+                | VK_FORMAT_FEATURE_BLIT_SRC_BIT
+                | VK_FORMAT_FEATURE_BLIT_DST_BIT
+                | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+        if ((formatProperties.optimalTilingFeatures & requiredFeatures) != requiredFeatures)
+        {
+            throw std::runtime_error("The output format does not support linear blits, dynamic resolution is unavailable!");
+        }
+    }
+
+    void DynamicResolution::createSceneTargets()
+    {
+        framebuffers.reset();
+        sceneImageViews.reset();
+        sceneTargets.reset();
+
+        sceneTargets = std::make_unique<OffscreenTargets>(
+                physicalDevice,
+                device,
+                targetExtent,
+                framesInFlight,
+                resourcePools,
+                *targetFormat
+                );
+        sceneImageViews = std::make_unique<SwapchainImageViews>(
+                device,
+                sceneTargets->getImages(),
+                sceneTargets->getImageFormat()
+                );
+        framebuffers = std::make_unique<Framebuffers>(
+                device,
+                sceneImageViews->getSwapchainImageViews(),
+                renderPass->getRenderPass(),
+                sceneTargets->getExtent()
+                );
+    }
+
+    void DynamicResolution::update(uint32_t frame, double gpuMilliseconds)
+    {
+        if (gpuMilliseconds <= 0.0)
+        {
+            return;
+        }
+
+        double ratio = budgetMilliseconds / gpuMilliseconds;
+        if (std::abs(ratio - 1.0) < SCALE_DEAD_BAND)
+        {
+            return;
+        }
+
+        // GPU time grows with the pixel count, the square of the scale
+        double balancedScale = frameScales[frame] * std::sqrt(ratio);
+        scale = std::clamp(scale + (balancedScale - scale) * SCALE_GAIN, minScale, 1.0);
+        metrics::getRendererMetrics().resolutionScale.set(scale);
+    }
+
+    void DynamicResolution::setTargets(std::vector<VkImage>* targetImages, VkExtent2D targetExtent)
+    {
+        this->targetImages = targetImages;
+        this->targetExtent = targetExtent;
+        createSceneTargets();
+    }
+
+    VkExtent2D DynamicResolution::beginFrame(uint32_t frame)
+    {
+        auto scaleDimension = [this](uint32_t dimension) {
+            auto scaled = static_cast<uint32_t>(std::lround(dimension * scale / EXTENT_GRANULARITY)) * EXTENT_GRANULARITY;
+            return std::clamp(scaled, std::min(EXTENT_GRANULARITY, dimension), dimension);
+        };
+
+        frameScales[frame] = scale;
+        frameExtents[frame] = VkExtent2D{scaleDimension(targetExtent.width), scaleDimension(targetExtent.height)};
+        return frameExtents[frame];
+    }
+
+    void DynamicResolution::recordUpscale(VkCommandBuffer commandBuffer, uint32_t frame, uint32_t imageIndex)
+    {
+        VkImage sceneImage = (*sceneTargets->getImages())[frame];
+        VkImage targetImage = (*targetImages)[imageIndex];
+        VkExtent2D sceneExtent = frameExtents[frame];
+
+        // The scene pass's external dependency orders its writes and its transition to TRANSFER_SRC before the blit.
+        // The output image is acquired at COLOR_ATTACHMENT_OUTPUT, the barrier chains on that wait.
+        VkImageMemoryBarrier toTransfer{};
+        toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        toTransfer.srcAccessMask = 0;
+        toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        toTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.image = targetImage;
+        toTransfer.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+
+        getDeviceDispatch().vkCmdPipelineBarrier(
+                commandBuffer,
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0,
+                0, nullptr,
+                0, nullptr,
+                1, &toTransfer
+                );
+
+        VkImageBlit region{};
+        region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.srcOffsets[1] = {static_cast<int32_t>(sceneExtent.width), static_cast<int32_t>(sceneExtent.height), 1};
+        region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.dstOffsets[1] = {static_cast<int32_t>(targetExtent.width), static_cast<int32_t>(targetExtent.height), 1};
+        getDeviceDispatch().vkCmdBlitImage(
+                commandBuffer,
+                sceneImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                targetImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                1, &region,
+                VK_FILTER_LINEAR
+                );
+
+        VkImageMemoryBarrier present{};
+        present.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        present.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        present.dstAccessMask = 0;
+        present.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        present.newLayout = targetFinalLayout;
+        present.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        present.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        present.image = targetImage;
+        present.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+
+        getDeviceDispatch().vkCmdPipelineBarrier(
+                commandBuffer,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                0,
+                0, nullptr,
+                0, nullptr,
+                1, &present
+                );
+    }
+
+    double DynamicResolution::getScale() const {
+        return scale;
+    }
+
+    VkRenderPass* DynamicResolution::getRenderPass() {
+        return renderPass->getRenderPass();
+    }
+
+    std::vector<VkFramebuffer>* DynamicResolution::getFramebuffers() {
+        return framebuffers->getFramebuffers();
+    }
+
+} // dvk
@@ -0,0 +1,123 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "FrameCapture.hpp"
+#include "ImageUtils.hpp"
+#include "Trace.hpp"
+
+namespace dvk {
+
+    FrameCapture::FrameCapture(const std::string& directory, CaptureFormat format) :
+        directory(directory),
+        format(format)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (error)
+        {
+            throw std::runtime_error("Failed to create capture directory " + directory + ": " + error.message());
+        }
+
+        writerThread = std::thread(&FrameCapture::writeLoop, this);
+    }
+
+    FrameCapture::~FrameCapture()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        condition.notify_one();
+        writerThread.join();
+    }
+
+    void FrameCapture::submit(ReadbackImage image)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            images.push_back(std::move(image));
+        }
+        condition.notify_one();
+    }
+
+    void FrameCapture::writeLoop()
+    {
+        DVK_TRACE_THREAD_NAME("frame capture");
+
+        for (;;)
+        {
+            ReadbackImage image;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this] { return stopping || !images.empty(); });
+                if (images.empty())
+                {
+                    break;
+                }
+                image = std::move(images.front());
+                images.pop_front();
+            }
+
+            // A failed write loses that capture, not the run
+            try {
+                write(image);
+            } catch (const std::exception& e) {
+                std::cerr << "Frame capture: " << e.what() << '\n';
+            }
+        }
+    }
+
+    void FrameCapture::write(const ReadbackImage& image)
+    {
+        DVK_TRACE_ZONE("writeCapture");
+        uint32_t bytesPerPixel = FrameReadback::getBytesPerPixel(image.format);
+
+        // Raw files carry their size and channel order in their name, they have no header
+        std::ostringstream name;
+        name << "frame_" << std::setw(6) << std::setfill('0') << image.frameNumber;
+        if (format == CaptureFormat::Png)
+        {
+            name << ".png";
+        }
+        else
+        {
+            name << "_" << image.width << "x" << image.height << (FrameReadback::isBgra(image.format) ? "_bgra8" : "_rgba8") << ".raw";
+        }
+        std::string path = (std::filesystem::path(directory) / name.str()).string();
+
+        if (format == CaptureFormat::Png)
+        {
+            utils::writePng(path, image.pixels, image.width, image.height, image.rowPitch, FrameReadback::isBgra(image.format));
+        }
+        else
+        {
+            utils::writeRaw(path, image.pixels, image.width, image.height, image.rowPitch, bytesPerPixel);
+        }
+
+        uint64_t hash = utils::hashPixels(image.pixels, image.width, image.height, image.rowPitch, bytesPerPixel);
+        std::ostringstream line;
+        line << "Captured frame " << image.frameNumber << " to " << path << " (fnv1a " << std::hex << std::setw(16)
+             << std::setfill('0') << hash << ")\n";
+        std::cerr << line.str();
+    }
+
+    CaptureFormat FrameCapture::parseCaptureFormat(const std::string& format)
+    {
+        if (format == "png")
+        {
+            return CaptureFormat::Png;
+        }
+        if (format == "raw")
+        {
+            return CaptureFormat::Raw;
+        }
+        throw std::runtime_error("Unknown capture format: " + format + ", expected png or raw");
+    }
+
+} // dvk
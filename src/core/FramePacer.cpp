@@ -0,0 +1,73 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include "FramePacer.hpp"
+
+namespace dvk {
+
+    static constexpr std::chrono::microseconds INITIAL_SPIN_MARGIN{1000};
+    static constexpr std::chrono::microseconds MIN_SPIN_MARGIN{100};
+
+    static std::chrono::steady_clock::duration toPeriod(double targetFramesPerSecond)
+    {
+        if (targetFramesPerSecond <= 0.0)
+        {
+            throw std::runtime_error("Frame pacer target rate must be positive!");
+        }
+        return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / targetFramesPerSecond));
+    }
+
+    FramePacer::FramePacer(double targetFramesPerSecond) :
+        period(toPeriod(targetFramesPerSecond)),
+        spinMargin(INITIAL_SPIN_MARGIN)
+    {
+
+    }
+
+    double FramePacer::wait()
+    {
+        Clock::time_point target = lastStart + period;
+        Clock::time_point now = Clock::now();
+        if (lastStart == Clock::time_point{})
+        {
+            lastStart = now;
+            return 0.0;
+        }
+        // Too late to catch up: the miss is reported, the schedule restarts from now
+        if (now >= target + period)
+        {
+            lastStart = now;
+            return std::chrono::duration<double>(now - target).count();
+        }
+
+        Clock::time_point wakeUp = target - spinMargin;
+        if (now < wakeUp)
+        {
+            std::this_thread::sleep_until(wakeUp);
+            now = Clock::now();
+
+            // Twice the last oversleep, or the previous margin decayed by 1/16 if that is larger
+            Clock::duration oversleep = std::max(now - wakeUp, Clock::duration::zero());
+            spinMargin = std::max({2 * oversleep, spinMargin - spinMargin / 16, Clock::duration(MIN_SPIN_MARGIN)});
+            spinMargin = std::min(spinMargin, period / 2);
+        }
+
+        while (now < target)
+        {
+            std::this_thread::yield();
+            now = Clock::now();
+        }
+
+        lastStart = target;
+        return std::chrono::duration<double>(now - target).count();
+    }
+
+    void FramePacer::reset() {
+        lastStart = Clock::time_point{};
+    }
+
+} // dvk
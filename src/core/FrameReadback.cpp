@@ -0,0 +1,319 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <stdexcept>
+#include <string>
+#include "FrameReadback.hpp"
+#include "MemoryUtils.hpp"
+#include "Metrics.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
+
+namespace dvk {
+
+    // Buffers on top of one per frame in flight, for the images still being written out
+    static constexpr uint32_t HELD_BUFFERS = 2;
+
+    ReadbackImage::ReadbackImage(std::atomic<bool>* held) :
+        held(held)
+    {
+    }
+
+    ReadbackImage::~ReadbackImage()
+    {
+        if (held != nullptr)
+        {
+            held->store(false, std::memory_order_release);
+        }
+    }
+
+    ReadbackImage::ReadbackImage(ReadbackImage&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    ReadbackImage& ReadbackImage::operator=(ReadbackImage&& other) noexcept
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+        if (held != nullptr)
+        {
+            held->store(false, std::memory_order_release);
+        }
+
+        held = other.held;
+        pixels = other.pixels;
+        width = other.width;
+        height = other.height;
+        rowPitch = other.rowPitch;
+        format = other.format;
+        frameNumber = other.frameNumber;
+        other.held = nullptr;
+        other.pixels = nullptr;
+        return *this;
+    }
+
+    FrameReadback::FrameReadback(VkPhysicalDevice* physicalDevice, VkDevice* device, VkFormat format, VkImageLayout targetLayout, uint32_t framesInFlight) :
+        physicalDevice(physicalDevice),
+        device(device),
+        format(format),
+        targetLayout(targetLayout),
+        bytesPerPixel(getBytesPerPixel(format))
+    {
+        frames.resize(framesInFlight);
+        // Created at the first copy, of the extent of the images copied
+        for (uint32_t i = 0; i < framesInFlight + HELD_BUFFERS; i++)
+        {
+            buffers.push_back(std::make_unique<Buffer>());
+        }
+    }
+
+    FrameReadback::~FrameReadback()
+    {
+        // Images still held must have been destroyed, like everything recorded, the device is idle by now
+        for (auto& buffer : buffers)
+        {
+            destroyBuffer(*buffer);
+        }
+    }
+
+    void FrameReadback::destroyBuffer(Buffer& buffer)
+    {
+        if (buffer.buffer == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        getDeviceDispatch().vkUnmapMemory(*device, buffer.memory);
+        getDeviceDispatch().vkDestroyBuffer(*device, buffer.buffer, memory::getAllocationCallbacks());
+        getDeviceDispatch().vkFreeMemory(*device, buffer.memory, memory::getAllocationCallbacks());
+        metrics::getRendererMetrics().onDeviceFree();
+        buffer.buffer = VK_NULL_HANDLE;
+        buffer.memory = VK_NULL_HANDLE;
+        buffer.capacity = 0;
+        buffer.mapped = nullptr;
+    }
+
+    void FrameReadback::createBuffer(Buffer& buffer, VkDeviceSize size)
+    {
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = size;
+        bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        if (getDeviceDispatch().vkCreateBuffer(*device, &bufferInfo, memory::getAllocationCallbacks(), &buffer.buffer) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create readback buffer!");
+        }
+
+        VkMemoryRequirements memRequirements;
+        getDeviceDispatch().vkGetBufferMemoryRequirements(*device, buffer.buffer, &memRequirements);
+
+        // Cached memory is read by the CPU at memory speed, uncached memory would make every read a trip over the bus.
+        // It is rarely coherent, the range is invalidated before it is read.
+        uint32_t memoryType;
+        if (!utils::tryFindMemoryType(
+                *physicalDevice,
+                memRequirements.memoryTypeBits,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+                memoryType))
+        {
+            memoryType = utils::findMemoryType(
+                    *physicalDevice,
+                    memRequirements.memoryTypeBits,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+            );
+        }
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memRequirements.size;
+        allocInfo.memoryTypeIndex = memoryType;
+
+        if (getDeviceDispatch().vkAllocateMemory(*device, &allocInfo, memory::getAllocationCallbacks(), &buffer.memory) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to allocate readback buffer memory!");
+        }
+        metrics::getRendererMetrics().onDeviceAllocation();
+
+        getDeviceDispatch().vkBindBufferMemory(*device, buffer.buffer, buffer.memory, 0);
+
+        void* data;
+        if (getDeviceDispatch().vkMapMemory(*device, buffer.memory, 0, VK_WHOLE_SIZE, 0, &data) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to map readback buffer memory!");
+        }
+        buffer.mapped = static_cast<uint8_t*>(data);
+        buffer.capacity = size;
+    }
+
+    FrameReadback::Buffer* FrameReadback::findFreeBuffer()
+    {
+        for (auto& buffer : buffers)
+        {
+            if (!buffer->held.load(std::memory_order_acquire))
+            {
+                return buffer.get();
+            }
+        }
+        return nullptr;
+    }
+
+    void FrameReadback::request(ReadbackCallback callback) {
+        requests.push_back(std::move(callback));
+    }
+
+    void FrameReadback::beginFrame(uint32_t frame, uint64_t frameNumber)
+    {
+        collect(frame);
+        this->frameNumber = frameNumber;
+    }
+
+    void FrameReadback::record(VkCommandBuffer commandBuffer, uint32_t frame, VkImage image, VkExtent2D extent)
+    {
+        if (requests.empty())
+        {
+            return;
+        }
+
+        Buffer* buffer = findFreeBuffer();
+        if (buffer == nullptr)
+        {
+            return;
+        }
+
+        VkDeviceSize size = static_cast<VkDeviceSize>(extent.width) * extent.height * bytesPerPixel;
+        if (buffer->capacity < size)
+        {
+            // Not in use by the GPU: it is only released once its copy was collected
+            destroyBuffer(*buffer);
+            createBuffer(*buffer, size);
+        }
+        buffer->held.store(true, std::memory_order_relaxed);
+
+        FrameCopy& copy = frames[frame];
+        copy.buffer = buffer;
+        copy.extent = extent;
+        copy.frameNumber = frameNumber;
+        copy.callback = std::move(requests.front());
+        requests.erase(requests.begin());
+
+        const DeviceDispatch& dispatch = getDeviceDispatch();
+
+        // Written by the render pass, whose external dependency orders its writes and final transition before
+        // transfers, or by the upscale blit
+        VkImageMemoryBarrier toTransfer{};
+        toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        toTransfer.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        toTransfer.oldLayout = targetLayout;
+        toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.image = image;
+        toTransfer.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        dispatch.vkCmdPipelineBarrier(
+                commandBuffer,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0,
+                0, nullptr,
+                0, nullptr,
+                1, &toTransfer
+                );
+
+        VkBufferImageCopy region{};
+        region.bufferOffset = 0;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.imageOffset = {0, 0, 0};
+        region.imageExtent = {extent.width, extent.height, 1};
+        dispatch.vkCmdCopyImageToBuffer(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, buffer->buffer, 1, &region);
+
+        // Back to the layout presentation expects, and the copy made visible to the host reads after the fence
+        VkImageMemoryBarrier toTarget = toTransfer;
+        toTarget.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        toTarget.dstAccessMask = 0;
+        toTarget.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        toTarget.newLayout = targetLayout;
+
+        VkBufferMemoryBarrier toHost{};
+        toHost.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        toHost.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        toHost.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        toHost.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toHost.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toHost.buffer = buffer->buffer;
+        toHost.offset = 0;
+        toHost.size = size;
+        dispatch.vkCmdPipelineBarrier(
+                commandBuffer,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+                0,
+                0, nullptr,
+                1, &toHost,
+                1, &toTarget
+                );
+    }
+
+    void FrameReadback::collect(uint32_t frame)
+    {
+        FrameCopy& copy = frames[frame];
+        if (copy.buffer == nullptr)
+        {
+            return;
+        }
+
+        VkMappedMemoryRange range{};
+        range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range.memory = copy.buffer->memory;
+        range.offset = 0;
+        range.size = VK_WHOLE_SIZE;
+        getDeviceDispatch().vkInvalidateMappedMemoryRanges(*device, 1, &range);
+
+        ReadbackImage image(&copy.buffer->held);
+        image.pixels = copy.buffer->mapped;
+        image.width = copy.extent.width;
+        image.height = copy.extent.height;
+        image.rowPitch = copy.extent.width * bytesPerPixel;
+        image.format = format;
+        image.frameNumber = copy.frameNumber;
+
+        ReadbackCallback callback = std::move(copy.callback);
+        copy = FrameCopy{};
+        callback(std::move(image));
+    }
+
+    void FrameReadback::collectAll()
+    {
+        for (uint32_t frame = 0; frame < frames.size(); frame++)
+        {
+            collect(frame);
+        }
+    }
+
+    uint32_t FrameReadback::getBytesPerPixel(VkFormat format)
+    {
+        switch (format)
+        {
+            case VK_FORMAT_B8G8R8A8_SRGB:
+            case VK_FORMAT_B8G8R8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+            case VK_FORMAT_R8G8B8A8_UNORM:
+                return 4;
+            default:
+                throw std::runtime_error("Frames of format " + std::to_string(format) + " cannot be read back!");
+        }
+    }
+
+    bool FrameReadback::isBgra(VkFormat format) {
+        return format == VK_FORMAT_B8G8R8A8_SRGB || format == VK_FORMAT_B8G8R8A8_UNORM;
+    }
+
+} // dvk
@@ -4,6 +4,8 @@
 
 #include <stdexcept>
 #include "Framebuffers.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
 
 namespace dvk {
     Framebuffers::Framebuffers(VkDevice *device, std::vector<VkImageView>* swapChainImageViews, VkRenderPass* renderPass, VkExtent2D* swapchainExtent) :
@@ -17,7 +19,7 @@ namespace dvk {
 
     Framebuffers::~Framebuffers() {
         for(auto framebuffer : swapchainFramebuffers){
-            vkDestroyFramebuffer(*device, framebuffer, nullptr);
+            getDeviceDispatch().vkDestroyFramebuffer(*device, framebuffer, memory::getAllocationCallbacks());
         }
     }
 
@@ -40,7 +42,7 @@ namespace dvk {
             framebufferInfo.height = swapchainExtent->height;
             framebufferInfo.width = swapchainExtent->width;
 
-            if (vkCreateFramebuffer(*device, &framebufferInfo, nullptr, &swapchainFramebuffers[i]) != VK_SUCCESS){
+            if (getDeviceDispatch().vkCreateFramebuffer(*device, &framebufferInfo, memory::getAllocationCallbacks(), &swapchainFramebuffers[i]) != VK_SUCCESS){
                 throw std::runtime_error("Failed to create framebuffer!");
             }
         }
@@ -0,0 +1,318 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <stdexcept>
+#include <algorithm>
+#include <array>
+#include "GpuScene.hpp"
+#include "MemoryUtils.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
+
+namespace dvk {
+
+    static constexpr uint32_t MAX_SCENE_MESHES = 256;
+    static constexpr uint32_t CULL_GROUP_SIZE = 64;
+
+    // Push constants of cull.comp
+    struct CullConstants {
+        glm::vec4 view;
+        uint32_t objectCount;
+        uint32_t objectCapacity;
+        uint32_t commandBase;
+        uint32_t countBase;
+    };
+
+    GpuScene::GpuScene(
+            VkPhysicalDevice* physicalDevice,
+            VkDevice* device,
+            uint32_t objectCapacity,
+            uint32_t batchCapacity,
+            uint32_t framesInFlight,
+            std::vector<uint32_t> queueFamilies,
+            ResourcePools* resourcePools
+            ) :
+        physicalDevice(physicalDevice),
+        device(device),
+        resourcePools(resourcePools),
+        objectCapacity(objectCapacity),
+        batchCapacity(batchCapacity),
+        framesInFlight(framesInFlight),
+        queueFamilies(std::move(queueFamilies)),
+        rendererMetrics(&metrics::getRendererMetrics())
+    {
+        if (static_cast<uint64_t>(objectCapacity) * batchCapacity * framesInFlight > UINT32_MAX)
+        {
+            throw std::runtime_error("GPU scene capacity exceeds the indirect command range!");
+        }
+
+        batches.reserve(batchCapacity);
+        createBuffer(static_cast<VkDeviceSize>(objectCapacity) * sizeof(InstanceData), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, true, instances);
+        createBuffer(static_cast<VkDeviceSize>(objectCapacity) * sizeof(GpuObject), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, true, objects);
+        createBuffer(MAX_SCENE_MESHES * sizeof(GpuMesh), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, true, meshes);
+        createBuffer(
+                static_cast<VkDeviceSize>(objectCapacity) * batchCapacity * framesInFlight * sizeof(VkDrawIndirectCommand),
+                VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                false,
+                commands
+        );
+        createBuffer(
+                static_cast<VkDeviceSize>(batchCapacity) * framesInFlight * sizeof(uint32_t),
+                VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                false,
+                counts
+        );
+        createDescriptors();
+    }
+
+    GpuScene::~GpuScene() {
+        cullPipeline.reset();
+
+        destroyBuffer(counts);
+        destroyBuffer(commands);
+        destroyBuffer(meshes);
+        destroyBuffer(objects);
+        destroyBuffer(instances);
+    }
+
+    void GpuScene::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, bool hostVisible, SceneBuffer& sceneBuffer)
+    {
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = size;
+        bufferInfo.usage = usage;
+        bufferInfo.sharingMode = queueFamilies.size() > 1 ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+        bufferInfo.queueFamilyIndexCount = queueFamilies.size() > 1 ? static_cast<uint32_t>(queueFamilies.size()) : 0;
+        bufferInfo.pQueueFamilyIndices = queueFamilies.data();
+
+        if (getDeviceDispatch().vkCreateBuffer(*device, &bufferInfo, memory::getAllocationCallbacks(), &sceneBuffer.buffer) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create GPU scene buffer!");
+        }
+
+        VkMemoryRequirements memRequirements;
+        getDeviceDispatch().vkGetBufferMemoryRequirements(*device, sceneBuffer.buffer, &memRequirements);
+
+        // Host written buffers are mapped for good, in device local memory when the device exposes it as host visible
+        uint32_t memoryType;
+        if (!hostVisible)
+        {
+            memoryType = utils::findMemoryType(*physicalDevice, memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        }
+        else if (!utils::tryFindMemoryType(
+                *physicalDevice,
+                memRequirements.memoryTypeBits,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                memoryType))
+        {
+            memoryType = utils::findMemoryType(
+                    *physicalDevice,
+                    memRequirements.memoryTypeBits,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+            );
+        }
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memRequirements.size;
+        allocInfo.memoryTypeIndex = memoryType;
+
+        if (getDeviceDispatch().vkAllocateMemory(*device, &allocInfo, memory::getAllocationCallbacks(), &sceneBuffer.memory) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to allocate GPU scene buffer memory!");
+        }
+        rendererMetrics->onDeviceAllocation();
+
+        getDeviceDispatch().vkBindBufferMemory(*device, sceneBuffer.buffer, sceneBuffer.memory, 0);
+
+        if (hostVisible && getDeviceDispatch().vkMapMemory(*device, sceneBuffer.memory, 0, size, 0, &sceneBuffer.mapped) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to map GPU scene buffer memory!");
+        }
+
+        sceneBuffer.handle = resourcePools->getBuffers()->insert(BufferResource{sceneBuffer.buffer, sceneBuffer.memory, size});
+    }
+
+    void GpuScene::destroyBuffer(SceneBuffer& sceneBuffer)
+    {
+        resourcePools->getBuffers()->remove(sceneBuffer.handle);
+
+        if (sceneBuffer.mapped != nullptr)
+        {
+            getDeviceDispatch().vkUnmapMemory(*device, sceneBuffer.memory);
+        }
+        getDeviceDispatch().vkDestroyBuffer(*device, sceneBuffer.buffer, memory::getAllocationCallbacks());
+        getDeviceDispatch().vkFreeMemory(*device, sceneBuffer.memory, memory::getAllocationCallbacks());
+        rendererMetrics->onDeviceFree();
+    }
+
+    void GpuScene::createDescriptors()
+    {
+        // The frame's slices of commands and counts are selected with push constants, one set serves every frame
+        std::array<SceneBuffer*, 5> buffers{&instances, &objects, &meshes, &commands, &counts};
+
+        std::vector<VkDescriptorSetLayoutBinding> bindings(buffers.size());
+        for (uint32_t i = 0; i < bindings.size(); i++)
+        {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+
+        cullPipeline = std::make_unique<ComputePipeline>(device, "cull.comp.spv", bindings, sizeof(CullConstants), 1, resourcePools);
+        descriptorSet = cullPipeline->allocateDescriptorSet();
+        for (uint32_t i = 0; i < buffers.size(); i++)
+        {
+            cullPipeline->writeBuffer(descriptorSet, i, buffers[i]->buffer);
+        }
+    }
+
+    uint32_t GpuScene::addMesh(MeshHandle mesh, const std::vector<Vertex>& vertices)
+    {
+        const MeshResource* meshResource = resourcePools->getMeshes()->get(mesh);
+        if (meshResource == nullptr)
+        {
+            throw std::runtime_error("Adding a stale mesh handle to the GPU scene!");
+        }
+        if (meshCount == MAX_SCENE_MESHES)
+        {
+            throw std::runtime_error("GPU scene mesh capacity exceeded!");
+        }
+        if (!vertexBuffer.isNull() && meshResource->vertexBuffer != vertexBuffer)
+        {
+            throw std::runtime_error("GPU scene meshes must share one vertex buffer!");
+        }
+        vertexBuffer = meshResource->vertexBuffer;
+
+        glm::vec2 min(0.0f);
+        glm::vec2 max(0.0f);
+        for (uint32_t i = 0; i < meshResource->vertexCount; i++)
+        {
+            const glm::vec2& position = vertices[meshResource->firstVertex + i].pos;
+            min = i == 0 ? position : glm::min(min, position);
+            max = i == 0 ? position : glm::max(max, position);
+        }
+
+        GpuMesh& gpuMesh = static_cast<GpuMesh*>(meshes.mapped)[meshCount];
+        gpuMesh.bounds = glm::vec4((min + max) * 0.5f, (max - min) * 0.5f);
+        gpuMesh.vertexCount = meshResource->vertexCount;
+        gpuMesh.firstVertex = meshResource->firstVertex;
+        return meshCount++;
+    }
+
+    uint32_t GpuScene::addBatch(PipelineHandle pipeline)
+    {
+        if (batches.size() == batchCapacity)
+        {
+            throw std::runtime_error("GPU scene batch capacity exceeded!");
+        }
+        batches.push_back(pipeline);
+        return static_cast<uint32_t>(batches.size() - 1);
+    }
+
+    uint32_t GpuScene::addObject(uint32_t mesh, uint32_t batch, const InstanceData& instance)
+    {
+        if (objectCount == objectCapacity)
+        {
+            throw std::runtime_error("GPU scene object capacity exceeded!");
+        }
+        if (mesh >= meshCount || batch >= batches.size())
+        {
+            throw std::runtime_error("GPU scene object references an unknown mesh or batch!");
+        }
+
+        static_cast<InstanceData*>(instances.mapped)[objectCount] = instance;
+        static_cast<GpuObject*>(objects.mapped)[objectCount] = GpuObject{mesh, batch};
+        rendererMetrics->uploadedBytes.add(sizeof(InstanceData) + sizeof(GpuObject));
+        return objectCount++;
+    }
+
+    void GpuScene::recordCulling(VkCommandBuffer commandBuffer, uint32_t frame)
+    {
+        uint32_t countBase = frame * batchCapacity;
+        getDeviceDispatch().vkCmdFillBuffer(commandBuffer, counts.buffer, countBase * sizeof(uint32_t), batchCapacity * sizeof(uint32_t), 0);
+
+        VkMemoryBarrier clearBarrier{};
+        clearBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        clearBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        clearBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        getDeviceDispatch().vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &clearBarrier, 0, nullptr, 0, nullptr);
+
+        if (objectCount > 0)
+        {
+            // The view is the clip space rectangle, the instanced shader places objects directly in it
+            CullConstants constants{};
+            constants.view = glm::vec4(-1.0f, -1.0f, 1.0f, 1.0f);
+            constants.objectCount = objectCount;
+            constants.objectCapacity = objectCapacity;
+            constants.commandBase = frame * batchCapacity * objectCapacity;
+            constants.countBase = countBase;
+
+            cullPipeline->bind(commandBuffer, descriptorSet);
+            cullPipeline->pushConstants(commandBuffer, &constants, sizeof(CullConstants));
+            cullPipeline->dispatch(commandBuffer, (objectCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE);
+        }
+
+        VkMemoryBarrier cullBarrier{};
+        cullBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        cullBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        cullBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+        getDeviceDispatch().vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 1, &cullBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    uint32_t GpuScene::recordDraws(VkCommandBuffer commandBuffer, uint32_t frame, UniformRing* uniformRing)
+    {
+        if (batches.empty())
+        {
+            return 0;
+        }
+
+        const BufferResource* vertexBufferResource = resourcePools->getBuffers()->get(vertexBuffer);
+        if (vertexBufferResource == nullptr)
+        {
+            throw std::runtime_error("Recording the GPU scene with a stale vertex buffer!");
+        }
+
+        VkBuffer vertexBuffers[] = {vertexBufferResource->buffer, instances.buffer};
+        VkDeviceSize offsets[] = {0, 0};
+        getDeviceDispatch().vkCmdBindVertexBuffers(commandBuffer, 0, 2, vertexBuffers, offsets);
+
+        uint32_t uniformOffset = 0;
+        if (uniformRing != nullptr)
+        {
+            auto* uniforms = uniformRing->allocate<DrawUniforms>(frame, uniformOffset);
+            uniforms->transform = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+            uniforms->color = glm::vec4(1.0f);
+        }
+
+        for (uint32_t batch = 0; batch < batches.size(); batch++)
+        {
+            const PipelineResource* pipelineResource = resourcePools->getPipelines()->get(batches[batch]);
+            if (pipelineResource == nullptr)
+            {
+                throw std::runtime_error("Recording the GPU scene with a stale pipeline handle!");
+            }
+            getDeviceDispatch().vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineResource->pipeline);
+            if (uniformRing != nullptr)
+            {
+                uniformRing->bind(commandBuffer, pipelineResource->layout, frame, uniformOffset);
+            }
+
+            VkDeviceSize commandOffset = (static_cast<VkDeviceSize>(frame) * batchCapacity + batch) * objectCapacity * sizeof(VkDrawIndirectCommand);
+            VkDeviceSize countOffset = (static_cast<VkDeviceSize>(frame) * batchCapacity + batch) * sizeof(uint32_t);
+            getDeviceDispatch().vkCmdDrawIndirectCount(commandBuffer, commands.buffer, commandOffset, counts.buffer, countOffset, objectCapacity, sizeof(VkDrawIndirectCommand));
+        }
+
+        auto draws = static_cast<uint32_t>(batches.size());
+        rendererMetrics->pipelineBinds.add(draws);
+        rendererMetrics->drawCalls.add(draws);
+        return draws;
+    }
+
+    uint32_t GpuScene::getObjectCount() const {
+        return objectCount;
+    }
+
+} // dvk
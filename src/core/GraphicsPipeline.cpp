@@ -6,23 +6,40 @@
 #include <stdexcept>
 #include "GraphicsPipeline.hpp"
 #include "ShadersUtils.hpp"
+#include "Constants.hpp"
 #include "Vertex.hpp"
+#include "InstanceData.hpp"
+#include "Trace.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
 
 namespace dvk {
-    GraphicsPipeline::GraphicsPipeline(VkDevice *device, VkRenderPass *renderPass, VkExtent2D *swapChainExtent) :
+    GraphicsPipeline::GraphicsPipeline(VkDevice *device, VkRenderPass *renderPass, VkExtent2D *swapChainExtent, ResourcePools* resourcePools, BindlessDescriptors* bindlessDescriptors, UniformRing* uniformRing, bool instanced) :
         device(device),
         renderPass(renderPass),
-        swapChainExtent(swapChainExtent)
+        swapChainExtent(swapChainExtent),
+        resourcePools(resourcePools),
+        bindlessDescriptors(bindlessDescriptors),
+        uniformRing(uniformRing),
+        instanced(instanced)
     {
+        createPipelineLayout();
         createGraphicsPipeline();
+        pipelineHandle = resourcePools->getPipelines()->insert(PipelineResource{graphicsPipeline, pipelineLayout});
     }
 
     GraphicsPipeline::~GraphicsPipeline() {
-        vkDestroyShaderModule(*device, fragShaderModule, nullptr);
-        vkDestroyShaderModule(*device, vertShaderModule, nullptr);
+        resourcePools->getPipelines()->remove(pipelineHandle);
 
-        vkDestroyPipeline(*device, graphicsPipeline, nullptr);
-        vkDestroyPipelineLayout(*device, pipelineLayout, nullptr);
+        getDeviceDispatch().vkDestroyShaderModule(*device, fragShaderModule, memory::getAllocationCallbacks());
+        getDeviceDispatch().vkDestroyShaderModule(*device, vertShaderModule, memory::getAllocationCallbacks());
+
+        getDeviceDispatch().vkDestroyPipeline(*device, graphicsPipeline, memory::getAllocationCallbacks());
+        getDeviceDispatch().vkDestroyPipelineLayout(*device, pipelineLayout, memory::getAllocationCallbacks());
+        if (emptySetLayout != VK_NULL_HANDLE)
+        {
+            getDeviceDispatch().vkDestroyDescriptorSetLayout(*device, emptySetLayout, memory::getAllocationCallbacks());
+        }
     }
 
     VkShaderModule GraphicsPipeline::createShaderModule(const std::vector<char>& code)
@@ -33,7 +50,7 @@ namespace dvk {
         createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
 
         VkShaderModule shaderModule;
-        if (vkCreateShaderModule(*device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS)
+        if (getDeviceDispatch().vkCreateShaderModule(*device, &createInfo, memory::getAllocationCallbacks(), &shaderModule) != VK_SUCCESS)
         {
             throw std::runtime_error("Failed to create shader module!");
         }
@@ -41,13 +58,56 @@ namespace dvk {
         return shaderModule;
     }
 
-    void GraphicsPipeline::createGraphicsPipeline()
+    void GraphicsPipeline::createPipelineLayout()
     {
-        auto vertShaderCode = utils::readFile(R"(C:\Users\Arouay\Documents\Projects\draft-vk\resources\shaders\shader.spv)");
-        auto fragShaderCode = utils::readFile(R"(C:\Users\Arouay\Documents\Projects\draft-vk\resources\shaders\frag.spv)");
+        std::vector<VkDescriptorSetLayout> setLayouts;
+        if (bindlessDescriptors != nullptr)
+        {
+            setLayouts.push_back(*bindlessDescriptors->getDescriptorSetLayout());
+        }
+        else if (uniformRing != nullptr)
+        {
+            VkDescriptorSetLayoutCreateInfo emptyLayoutInfo{};
+            emptyLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            if (getDeviceDispatch().vkCreateDescriptorSetLayout(*device, &emptyLayoutInfo, memory::getAllocationCallbacks(), &emptySetLayout) != VK_SUCCESS){
+                throw std::runtime_error("failed to create empty descriptor set layout!");
+            }
+            setLayouts.push_back(emptySetLayout);
+        }
+        if (uniformRing != nullptr)
+        {
+            setLayouts.push_back(*uniformRing->getDescriptorSetLayout());
+        }
+
+        VkPushConstantRange pushConstantRange = BindlessDescriptors::getPushConstantRange();
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+        pipelineLayoutInfo.pSetLayouts = setLayouts.data();
+        pipelineLayoutInfo.pushConstantRangeCount = bindlessDescriptors != nullptr ? 1 : 0;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (getDeviceDispatch().vkCreatePipelineLayout(*device, &pipelineLayoutInfo, memory::getAllocationCallbacks(), &pipelineLayout) != VK_SUCCESS){
+            throw std::runtime_error("failed to create pipeline layout!");
+        }
+    }
 
-        auto bindingDescription = Vertex::getBindingDescription();
-        auto attributeDescription = Vertex::getAttributeDescription();
+    void GraphicsPipeline::createGraphicsPipeline()
+    {
+        DVK_TRACE_ZONE("createGraphicsPipeline");
+        auto vertShaderCode = utils::readFile(std::string(constants::shaders_Dir) + (instanced ? "instanced.vert.spv" : "shader.vert.spv"));
+        auto fragShaderCode = utils::readFile(std::string(constants::shaders_Dir) + "shader.frag.spv");
+
+        auto vertexAttributes = Vertex::getAttributeDescription();
+        std::vector<VkVertexInputBindingDescription> bindingDescriptions{Vertex::getBindingDescription()};
+        std::vector<VkVertexInputAttributeDescription> attributeDescriptions(vertexAttributes.begin(), vertexAttributes.end());
+        if (instanced)
+        {
+            auto instanceAttributes = InstanceData::getAttributeDescription();
+            bindingDescriptions.push_back(InstanceData::getBindingDescription());
+            attributeDescriptions.insert(attributeDescriptions.end(), instanceAttributes.begin(), instanceAttributes.end());
+        }
 
         vertShaderModule = createShaderModule(vertShaderCode);
         fragShaderModule = createShaderModule(fragShaderCode);
@@ -68,10 +128,10 @@ namespace dvk {
 
         VkPipelineVertexInputStateCreateInfo vertexInputState{};
         vertexInputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-        vertexInputState.vertexBindingDescriptionCount = 1;
-        vertexInputState.pVertexBindingDescriptions = &bindingDescription;
-        vertexInputState.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescription.size());
-        vertexInputState.pVertexAttributeDescriptions = attributeDescription.data();
+        vertexInputState.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size());
+        vertexInputState.pVertexBindingDescriptions = bindingDescriptions.data();
+        vertexInputState.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+        vertexInputState.pVertexAttributeDescriptions = attributeDescriptions.data();
 
         VkPipelineInputAssemblyStateCreateInfo inputAssemblyState{};
         inputAssemblyState.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
@@ -151,17 +211,6 @@ namespace dvk {
         dynamicState.dynamicStateCount = 3;
         dynamicState.pDynamicStates = dynamicStates;
 
-        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        pipelineLayoutInfo.setLayoutCount = 0;
-        pipelineLayoutInfo.pSetLayouts = nullptr;
-        pipelineLayoutInfo.pushConstantRangeCount = 0;
-        pipelineLayoutInfo.pPushConstantRanges = nullptr;
-
-        if (vkCreatePipelineLayout(*device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS){
-            throw std::runtime_error("failed to create pipeline layout!");
-        }
-
         VkGraphicsPipelineCreateInfo graphicsPipelineInfo{};
         graphicsPipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
         graphicsPipelineInfo.stageCount = 2;
@@ -180,7 +229,7 @@ namespace dvk {
         graphicsPipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
         graphicsPipelineInfo.basePipelineIndex = -1;
 
-        if (vkCreateGraphicsPipelines(*device, VK_NULL_HANDLE, 1, &graphicsPipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS){
+        if (getDeviceDispatch().vkCreateGraphicsPipelines(*device, VK_NULL_HANDLE, 1, &graphicsPipelineInfo, memory::getAllocationCallbacks(), &graphicsPipeline) != VK_SUCCESS){
             throw std::runtime_error("Failed to create graphics pipeline!");
         }
     }
@@ -188,4 +237,8 @@ namespace dvk {
     VkPipeline *GraphicsPipeline::getGraphicsPipeline() {
         return &graphicsPipeline;
     }
+
+    PipelineHandle GraphicsPipeline::getPipelineHandle() const {
+        return pipelineHandle;
+    }
 } // dvk
\ No newline at end of file
@@ -6,14 +6,15 @@
 #include "Instance.hpp"
 #include "Constants.hpp"
 #include "ExtentionsUtils.hpp"
+#include "HostAllocator.hpp"
 
 namespace dvk {
-    Instance::Instance() {
+    Instance::Instance(bool headless) : headless(headless) {
         init();
     }
 
     Instance::~Instance() {
-        vkDestroyInstance(instance, nullptr);
+        vkDestroyInstance(instance, memory::getAllocationCallbacks());
     }
 
     void Instance::init() {
@@ -29,7 +30,7 @@ namespace dvk {
         createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
         createInfo.pApplicationInfo = &appInfo;
 
-        std::vector<const char*> glfwExtensions = utils::getRequiredExtensions();
+        std::vector<const char*> glfwExtensions = utils::getRequiredExtensions(headless);
         createInfo.enabledExtensionCount = static_cast<uint32_t>(glfwExtensions.size());
         createInfo.ppEnabledExtensionNames = glfwExtensions.data();
 
@@ -58,7 +59,7 @@ namespace dvk {
         Debug::checkValidationLayerSupport();
         utils::checkExtensionsCompatibility(glfwExtensions, extensions);
 
-        if (vkCreateInstance(&createInfo, nullptr, &instance) != VK_SUCCESS)
+        if (vkCreateInstance(&createInfo, memory::getAllocationCallbacks(), &instance) != VK_SUCCESS)
         {
             throw std::runtime_error("Failed to create an instance!");
         }
@@ -0,0 +1,141 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <stdexcept>
+#include "InstanceBuffer.hpp"
+#include "MemoryUtils.hpp"
+#include "Metrics.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
+
+namespace dvk {
+
+    // Draws of one frame before its draw list has to grow
+    static constexpr size_t RESERVED_DRAWS = 64;
+
+    InstanceBuffer::InstanceBuffer(VkPhysicalDevice* physicalDevice, VkDevice* device, uint32_t capacity, uint32_t framesInFlight, ResourcePools* resourcePools) :
+        physicalDevice(physicalDevice),
+        device(device),
+        resourcePools(resourcePools),
+        capacity(capacity),
+        framesInFlight(framesInFlight)
+    {
+        frames.resize(framesInFlight);
+        for (auto& frame : frames)
+        {
+            frame.draws.reserve(RESERVED_DRAWS);
+        }
+        createBuffer();
+    }
+
+    InstanceBuffer::~InstanceBuffer() {
+        resourcePools->getBuffers()->remove(bufferHandle);
+
+        getDeviceDispatch().vkUnmapMemory(*device, bufferMemory);
+        getDeviceDispatch().vkDestroyBuffer(*device, buffer, memory::getAllocationCallbacks());
+        getDeviceDispatch().vkFreeMemory(*device, bufferMemory, memory::getAllocationCallbacks());
+        metrics::getRendererMetrics().onDeviceFree();
+    }
+
+    void InstanceBuffer::createBuffer()
+    {
+        VkDeviceSize size = static_cast<VkDeviceSize>(capacity) * framesInFlight * sizeof(InstanceData);
+
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = size;
+        bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        if (getDeviceDispatch().vkCreateBuffer(*device, &bufferInfo, memory::getAllocationCallbacks(), &buffer) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create instance buffer!");
+        }
+
+        VkMemoryRequirements memRequirements;
+        getDeviceDispatch().vkGetBufferMemoryRequirements(*device, buffer, &memRequirements);
+
+        // Device local and host visible memory (resizable BAR, integrated GPUs) saves the vertex fetch a trip over the bus
+        uint32_t memoryType;
+        if (!utils::tryFindMemoryType(
+                *physicalDevice,
+                memRequirements.memoryTypeBits,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                memoryType))
+        {
+            memoryType = utils::findMemoryType(
+                    *physicalDevice,
+                    memRequirements.memoryTypeBits,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+            );
+        }
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memRequirements.size;
+        allocInfo.memoryTypeIndex = memoryType;
+
+        if (getDeviceDispatch().vkAllocateMemory(*device, &allocInfo, memory::getAllocationCallbacks(), &bufferMemory) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to allocate instance buffer memory!");
+        }
+        metrics::getRendererMetrics().onDeviceAllocation();
+
+        getDeviceDispatch().vkBindBufferMemory(*device, buffer, bufferMemory, 0);
+
+        void* data;
+        if (getDeviceDispatch().vkMapMemory(*device, bufferMemory, 0, size, 0, &data) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to map instance buffer memory!");
+        }
+        mapped = static_cast<InstanceData*>(data);
+
+        bufferHandle = resourcePools->getBuffers()->insert(BufferResource{buffer, bufferMemory, size});
+    }
+
+    void InstanceBuffer::beginFrame(uint32_t frame) {
+        frames[frame].count = 0;
+        frames[frame].draws.clear();
+    }
+
+    InstanceData* InstanceBuffer::allocate(uint32_t frame, MeshHandle mesh, uint32_t count)
+    {
+        FrameInstances& instances = frames[frame];
+        if (count > capacity - instances.count)
+        {
+            throw std::runtime_error("Instance buffer capacity exceeded!");
+        }
+
+        if (!instances.draws.empty() && instances.draws.back().mesh == mesh)
+        {
+            instances.draws.back().instanceCount += count;
+        }
+        else
+        {
+            instances.draws.push_back(InstancedDraw{mesh, instances.count, count});
+        }
+
+        InstanceData* data = mapped + static_cast<size_t>(frame) * capacity + instances.count;
+        instances.count += count;
+        metrics::getRendererMetrics().uploadedBytes.add(count * sizeof(InstanceData));
+        return data;
+    }
+
+    std::vector<InstancedDraw>* InstanceBuffer::getDraws(uint32_t frame) {
+        return &frames[frame].draws;
+    }
+
+    VkBuffer* InstanceBuffer::getBuffer() {
+        return &buffer;
+    }
+
+    VkDeviceSize InstanceBuffer::getFrameOffset(uint32_t frame) const {
+        return static_cast<VkDeviceSize>(frame) * capacity * sizeof(InstanceData);
+    }
+
+    uint32_t InstanceBuffer::getCapacity() const {
+        return capacity;
+    }
+
+} // dvk
@@ -0,0 +1,129 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <stdexcept>
+#include "OffscreenTargets.hpp"
+#include "Metrics.hpp"
+#include "MemoryUtils.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
+
+namespace dvk {
+
+    OffscreenTargets::OffscreenTargets(VkPhysicalDevice* physicalDevice, VkDevice* device, VkExtent2D extent, uint32_t imageCount, ResourcePools* resourcePools, VkFormat format) :
+        imageFormat(format),
+        extent(extent),
+        physicalDevice(physicalDevice),
+        device(device),
+        imageCount(imageCount),
+        resourcePools(resourcePools)
+    {
+        if (imageFormat == VK_FORMAT_UNDEFINED)
+        {
+            imageFormat = chooseImageFormat();
+        }
+        createImages();
+    }
+
+    OffscreenTargets::~OffscreenTargets() {
+        for (size_t i = 0; i < images.size(); i++)
+        {
+            resourcePools->getImages()->remove(imageHandles[i]);
+            getDeviceDispatch().vkDestroyImage(*device, images[i], memory::getAllocationCallbacks());
+            getDeviceDispatch().vkFreeMemory(*device, imageMemories[i], memory::getAllocationCallbacks());
+            metrics::getRendererMetrics().onDeviceFree();
+        }
+    }
+
+    VkFormat OffscreenTargets::chooseImageFormat()
+    {
+        // Same preference as the swapchain so both paths render identical pixels
+        const VkFormat candidates[] = {
+                VK_FORMAT_B8G8R8A8_SRGB,
+                VK_FORMAT_R8G8B8A8_SRGB,
+                VK_FORMAT_B8G8R8A8_UNORM,
+                VK_FORMAT_R8G8B8A8_UNORM
+        };
+        const VkFormatFeatureFlags requiredFeatures = VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT | VK_FORMAT_FEATURE_TRANSFER_SRC_BIT | VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
+
+        for (auto candidate : candidates)
+        {
+            VkFormatProperties formatProperties;
+            vkGetPhysicalDeviceFormatProperties(*physicalDevice, candidate, &formatProperties);
+
+            if ((formatProperties.optimalTilingFeatures & requiredFeatures) == requiredFeatures)
+            {
+                return candidate;
+            }
+        }
+
+        throw std::runtime_error("Failed to find a supported offscreen image format!");
+    }
+
+    void OffscreenTargets::createImages()
+    {
+        images.resize(imageCount);
+        imageMemories.resize(imageCount);
+
+        for (uint32_t i = 0; i < imageCount; i++)
+        {
+            VkImageCreateInfo imageInfo{};
+            imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.imageType = VK_IMAGE_TYPE_2D;
+            imageInfo.format = imageFormat;
+            imageInfo.extent = {extent.width, extent.height, 1};
+            imageInfo.mipLevels = 1;
+            imageInfo.arrayLayers = 1;
+            imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+            imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+            // Transfer destination for the dynamic resolution upscale
+            imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+            imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+            if (getDeviceDispatch().vkCreateImage(*device, &imageInfo, memory::getAllocationCallbacks(), &images[i]) != VK_SUCCESS)
+            {
+                throw std::runtime_error("Failed to create offscreen image!");
+            }
+
+            VkMemoryRequirements memRequirements;
+            getDeviceDispatch().vkGetImageMemoryRequirements(*device, images[i], &memRequirements);
+
+            VkMemoryAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            allocInfo.allocationSize = memRequirements.size;
+            allocInfo.memoryTypeIndex = utils::findMemoryType(
+                    *physicalDevice,
+                    memRequirements.memoryTypeBits,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+            );
+
+            if (getDeviceDispatch().vkAllocateMemory(*device, &allocInfo, memory::getAllocationCallbacks(), &imageMemories[i]) != VK_SUCCESS)
+            {
+                throw std::runtime_error("Failed to allocate offscreen image memory!");
+            }
+            metrics::getRendererMetrics().onDeviceAllocation();
+
+            getDeviceDispatch().vkBindImageMemory(*device, images[i], imageMemories[i], 0);
+            imageHandles.push_back(resourcePools->getImages()->insert(ImageResource{images[i], imageMemories[i], imageFormat, extent}));
+        }
+    }
+
+    std::vector<VkImage> *OffscreenTargets::getImages() {
+        return &images;
+    }
+
+    std::vector<ImageHandle> *OffscreenTargets::getImageHandles() {
+        return &imageHandles;
+    }
+
+    VkFormat *OffscreenTargets::getImageFormat() {
+        return &imageFormat;
+    }
+
+    VkExtent2D *OffscreenTargets::getExtent() {
+        return &extent;
+    }
+
+} // dvk
@@ -6,47 +6,60 @@ namespace dvk {
         return graphicsFamily.has_value() && presentationFamily.has_value();
     }
 
-    void QueueFamilyIndices::findQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface)
+    void QueueFamilyIndices::findQueueFamilies(const std::vector<VkQueueFamilyProperties>& queueFamilies, const std::vector<VkBool32>& presentationSupport)
     {
-        uint32_t queueFamilyCount = 0;
-        vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, nullptr);
-
-        std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
-        vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies.data());
-
-        VkBool32 presentationSupport = false;
-        int index = 0;
+        uint32_t index = 0;
         for (const auto& queueFamily : queueFamilies)
         {
-            if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)
+            if ((queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT) && !(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) && !dedicatedComputeFamily)
             {
-                graphicsFamily = index;
+                computeFamily = index;
+                dedicatedComputeFamily = true;
             }
 
-            vkGetPhysicalDeviceSurfaceSupportKHR(device, index, surface, &presentationSupport);
-            if (presentationSupport)
+            if (isComplete())
             {
-                presentationFamily = index;
+                index++;
+                continue;
             }
 
-            if (isComplete())
+            if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)
+            {
+                graphicsFamily = index;
+            }
+
+            if (presentationSupport[index])
             {
-                break;
+                presentationFamily = index;
             }
 
             index++;
         }
+
+        // Graphics families support compute too
+        if (!dedicatedComputeFamily)
+        {
+            computeFamily = graphicsFamily;
+        }
     }
 
-    QueueFamilyIndices::QueueFamilyIndices(VkPhysicalDevice* device, VkSurfaceKHR* surface) {
-        findQueueFamilies(*device, *surface);
+    QueueFamilyIndices::QueueFamilyIndices(const std::vector<VkQueueFamilyProperties>& queueFamilies, const std::vector<VkBool32>& presentationSupport) {
+        findQueueFamilies(queueFamilies, presentationSupport);
     }
 
-    uint32_t QueueFamilyIndices::getGraphicsFamilyValue() {
+    uint32_t QueueFamilyIndices::getGraphicsFamilyValue() const {
         return graphicsFamily.value();
     }
 
-    uint32_t QueueFamilyIndices::getPresentationFamilyValue() {
+    uint32_t QueueFamilyIndices::getPresentationFamilyValue() const {
         return presentationFamily.value();
     }
+
+    uint32_t QueueFamilyIndices::getComputeFamilyValue() const {
+        return computeFamily.value();
+    }
+
+    bool QueueFamilyIndices::hasDedicatedComputeFamily() const {
+        return dedicatedComputeFamily;
+    }
 }
\ No newline at end of file
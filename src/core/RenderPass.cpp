@@ -5,18 +5,21 @@
 #include <vulkan/vulkan_core.h>
 #include <stdexcept>
 #include "RenderPass.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
 
 namespace dvk {
 
-    RenderPass::RenderPass(VkDevice* device, VkFormat* swapchainImageFormat) :
+    RenderPass::RenderPass(VkDevice* device, VkFormat* swapchainImageFormat, VkImageLayout finalLayout) :
         device(device),
-        swapchainImageFormat(swapchainImageFormat)
+        swapchainImageFormat(swapchainImageFormat),
+        finalLayout(finalLayout)
     {
         createRenderPass();
     }
 
     RenderPass::~RenderPass() {
-        vkDestroyRenderPass(*device, renderPass, nullptr);
+        getDeviceDispatch().vkDestroyRenderPass(*device, renderPass, memory::getAllocationCallbacks());
     }
 
     void RenderPass::createRenderPass()
@@ -29,7 +32,7 @@ namespace dvk {
         colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
         colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        colorAttachment.finalLayout = finalLayout;
 
         VkAttachmentReference colorAttachmentReference{};
         colorAttachmentReference.attachment = 0;
@@ -40,13 +43,22 @@ namespace dvk {
         subpass.colorAttachmentCount = 1;
         subpass.pColorAttachments = &colorAttachmentReference;
 
-        VkSubpassDependency dependency{};
-        dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-        dependency.dstSubpass = 0;
-        dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-        dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-        dependency.srcAccessMask = 0;
-        dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        VkSubpassDependency dependencies[2]{};
+        dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[0].dstSubpass = 0;
+        dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependencies[0].srcAccessMask = 0;
+        dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+        // The upscale blit and the frame readback copy read the image after the pass, this orders them after its
+        // writes and its transition to the final layout. Presentation waits on the submission's semaphore.
+        dependencies[1].srcSubpass = 0;
+        dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependencies[1].dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        dependencies[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
 
         VkRenderPassCreateInfo renderPassInfo{};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
@@ -54,10 +66,10 @@ namespace dvk {
         renderPassInfo.pAttachments = &colorAttachment;
         renderPassInfo.subpassCount = 1;
         renderPassInfo.pSubpasses= &subpass;
-        renderPassInfo.dependencyCount = 1;
-        renderPassInfo.pDependencies = &dependency;
+        renderPassInfo.dependencyCount = 2;
+        renderPassInfo.pDependencies = dependencies;
 
-        if (vkCreateRenderPass(*device, &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS){
+        if (getDeviceDispatch().vkCreateRenderPass(*device, &renderPassInfo, memory::getAllocationCallbacks(), &renderPass) != VK_SUCCESS){
             throw std::runtime_error("Failed to create render pass!");
         }
     }
@@ -0,0 +1,171 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <algorithm>
+#include "RenderQueue.hpp"
+
+namespace dvk {
+
+    static constexpr uint32_t RADIX_BITS = 8;
+    static constexpr uint32_t RADIX_BUCKETS = 1u << RADIX_BITS;
+    // Below this, splitting a radix pass into tasks costs more than it saves
+    static constexpr uint32_t MIN_ENTRIES_PER_TASK = 4096;
+    static constexpr uint32_t MAX_SORT_TASKS = 16;
+
+    static constexpr uint64_t FIELD_BITS = 12;
+    static constexpr uint64_t FIELD_MASK = (1ull << FIELD_BITS) - 1;
+    static constexpr uint64_t DEPTH_BITS = 23;
+    static constexpr uint64_t DEPTH_MASK = (1ull << DEPTH_BITS) - 1;
+    static constexpr uint64_t PASS_MASK = 0xF;
+
+    RenderQueue::RenderQueue(ParallelExecutor* executor) :
+        executor(executor)
+    {
+
+    }
+
+    uint64_t RenderQueue::makeSortKey(const DrawPacket& packet)
+    {
+        auto depth = static_cast<uint64_t>(std::clamp(packet.depth, 0.0f, 1.0f) * static_cast<float>(DEPTH_MASK));
+        uint64_t pipeline = packet.pipeline.getIndex() & FIELD_MASK;
+        uint64_t material = packet.material & FIELD_MASK;
+        uint64_t mesh = packet.mesh.getIndex() & FIELD_MASK;
+        uint64_t key = (packet.pass & PASS_MASK) << 60;
+
+        if (packet.transparent)
+        {
+            key |= 1ull << 59;
+            key |= (DEPTH_MASK - depth) << 36;
+            key |= pipeline << 24 | material << 12 | mesh;
+        }
+        else
+        {
+            key |= pipeline << 47 | material << 35 | mesh << 23;
+            key |= depth;
+        }
+        return key;
+    }
+
+    void RenderQueue::clear() {
+        packets.clear();
+        entries.clear();
+        keysAnd = ~0ull;
+        keysOr = 0;
+    }
+
+    void RenderQueue::submit(const DrawPacket& packet)
+    {
+        uint64_t key = makeSortKey(packet);
+        keysAnd &= key;
+        keysOr |= key;
+
+        entries.push_back(SortEntry{key, static_cast<uint32_t>(packets.size())});
+        packets.push_back(packet);
+    }
+
+    void RenderQueue::sort() {
+        radixSort();
+    }
+
+    void RenderQueue::radixSort()
+    {
+        auto count = static_cast<uint32_t>(entries.size());
+        if (count < 2)
+        {
+            return;
+        }
+        // Only grows, so a steady draw count sorts without allocating
+        scratch.resize(count);
+
+        uint32_t taskCount = 1;
+        if (executor != nullptr)
+        {
+            taskCount = std::min({executor->getConcurrency(), MAX_SORT_TASKS, count / MIN_ENTRIES_PER_TASK});
+            taskCount = std::max(taskCount, 1u);
+        }
+        uint32_t chunkSize = (count + taskCount - 1) / taskCount;
+
+        uint32_t offsets[MAX_SORT_TASKS][RADIX_BUCKETS];
+        SortEntry* source = entries.data();
+        SortEntry* destination = scratch.data();
+        uint64_t varyingBits = keysAnd ^ keysOr;
+
+        for (uint32_t shift = 0; shift < 64; shift += RADIX_BITS)
+        {
+            if (((varyingBits >> shift) & (RADIX_BUCKETS - 1)) == 0)
+            {
+                continue;
+            }
+
+            // Each task counts the digits of its chunk, then scatters it stably to offsets that follow every
+            // lower digit and the same digit of the earlier chunks
+            auto countDigits = [&](uint32_t task) {
+                uint32_t* histogram = offsets[task];
+                std::fill(histogram, histogram + RADIX_BUCKETS, 0u);
+                uint32_t end = std::min(count, (task + 1) * chunkSize);
+                for (uint32_t i = task * chunkSize; i < end; i++)
+                {
+                    histogram[(source[i].key >> shift) & (RADIX_BUCKETS - 1)]++;
+                }
+            };
+            auto scatter = [&](uint32_t task) {
+                uint32_t* next = offsets[task];
+                uint32_t end = std::min(count, (task + 1) * chunkSize);
+                for (uint32_t i = task * chunkSize; i < end; i++)
+                {
+                    destination[next[(source[i].key >> shift) & (RADIX_BUCKETS - 1)]++] = source[i];
+                }
+            };
+
+            if (taskCount > 1)
+            {
+                executor->parallelFor(taskCount, countDigits);
+            }
+            else
+            {
+                countDigits(0);
+            }
+
+            uint32_t offset = 0;
+            for (uint32_t digit = 0; digit < RADIX_BUCKETS; digit++)
+            {
+                for (uint32_t task = 0; task < taskCount; task++)
+                {
+                    uint32_t digitCount = offsets[task][digit];
+                    offsets[task][digit] = offset;
+                    offset += digitCount;
+                }
+            }
+
+            if (taskCount > 1)
+            {
+                executor->parallelFor(taskCount, scatter);
+            }
+            else
+            {
+                scatter(0);
+            }
+
+            std::swap(source, destination);
+        }
+
+        if (source != entries.data())
+        {
+            entries.swap(scratch);
+        }
+    }
+
+    uint32_t RenderQueue::size() const {
+        return static_cast<uint32_t>(entries.size());
+    }
+
+    const DrawPacket& RenderQueue::getSorted(uint32_t index) const {
+        return packets[entries[index].packet];
+    }
+
+    void RenderQueue::setExecutor(ParallelExecutor* executor) {
+        this->executor = executor;
+    }
+
+} // dvk
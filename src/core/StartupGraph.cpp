@@ -0,0 +1,195 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <stdexcept>
+#include <string>
+#include "StartupGraph.hpp"
+#include "Trace.hpp"
+
+namespace dvk {
+
+    static double toMilliseconds(StartupGraph::Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    StartupGraph::StartupGraph(jobs::JobSystem* jobSystem) :
+        jobSystem(jobSystem)
+    {
+    }
+
+    uint32_t StartupGraph::add(const char* name, std::vector<uint32_t> dependencies, std::function<void()> body, bool mainThread)
+    {
+        auto index = static_cast<uint32_t>(stages.size());
+        auto stage = std::make_unique<Stage>();
+        stage->name = name;
+        stage->body = std::move(body);
+        stage->mainThread = mainThread;
+
+        for (uint32_t dependency : dependencies)
+        {
+            if (dependency == NO_STAGE)
+            {
+                continue;
+            }
+            if (dependency >= index)
+            {
+                throw std::runtime_error(std::string("Startup stage ") + name + " depends on a stage added after it!");
+            }
+            stages[dependency]->dependents.push_back(index);
+            stage->dependencyCount++;
+        }
+
+        stages.push_back(std::move(stage));
+        return index;
+    }
+
+    void StartupGraph::runStage(void* context, uint32_t begin, uint32_t)
+    {
+        static_cast<StartupGraph*>(context)->execute(begin);
+    }
+
+    void StartupGraph::schedule(uint32_t index)
+    {
+        if (stages[index]->mainThread)
+        {
+            std::lock_guard<std::mutex> lock(mainThreadMutex);
+            mainThreadStages.push_back(index);
+            return;
+        }
+        jobSystem->run(runStage, this, index, index + 1, nullptr);
+    }
+
+    void StartupGraph::execute(uint32_t index)
+    {
+        Stage& stage = *stages[index];
+        stage.ranOnMainThread = std::this_thread::get_id() == mainThread;
+        stage.begin = Clock::now();
+        if (!failed.load())
+        {
+            DVK_TRACE_ZONE(stage.name);
+            try {
+                stage.body();
+            } catch (...) {
+                if (!failed.exchange(true))
+                {
+                    error = std::current_exception();
+                }
+            }
+        }
+        stage.end = Clock::now();
+
+        if (parallel)
+        {
+            for (uint32_t dependent : stage.dependents)
+            {
+                if (stages[dependent]->remainingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    schedule(dependent);
+                }
+            }
+        }
+        // Last, the graph may be gone as soon as the count is complete
+        completedStages.fetch_add(1, std::memory_order_release);
+    }
+
+    bool StartupGraph::popMainThreadStage(uint32_t& index)
+    {
+        std::lock_guard<std::mutex> lock(mainThreadMutex);
+        if (mainThreadStages.empty())
+        {
+            return false;
+        }
+        index = mainThreadStages.back();
+        mainThreadStages.pop_back();
+        return true;
+    }
+
+    void StartupGraph::run(bool parallel)
+    {
+        DVK_TRACE_ZONE("startup");
+        this->parallel = parallel;
+        mainThread = std::this_thread::get_id();
+        begin = Clock::now();
+        auto stageCount = static_cast<uint32_t>(stages.size());
+
+        if (!parallel)
+        {
+            for (uint32_t i = 0; i < stageCount; i++)
+            {
+                execute(i);
+            }
+        }
+        else
+        {
+            for (auto& stage : stages)
+            {
+                stage->remainingDependencies.store(stage->dependencyCount, std::memory_order_relaxed);
+            }
+            for (uint32_t i = 0; i < stageCount; i++)
+            {
+                if (stages[i]->dependencyCount == 0)
+                {
+                    schedule(i);
+                }
+            }
+
+            // Main thread stages first, they are on the critical path of whatever needs the window
+            while (completedStages.load(std::memory_order_acquire) < stageCount)
+            {
+                uint32_t index;
+                if (popMainThreadStage(index))
+                {
+                    execute(index);
+                }
+                else if (!jobSystem->tryRunJob())
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        end = Clock::now();
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    double StartupGraph::getMilliseconds() const {
+        return toMilliseconds(end - begin);
+    }
+
+    void StartupGraph::writeReport(std::ostream& out, Clock::time_point processStart, Clock::time_point firstFrame) const
+    {
+        double stageTotal = 0.0;
+        for (const auto& stage : stages)
+        {
+            stageTotal += toMilliseconds(stage->end - stage->begin);
+        }
+
+        out << "{\n";
+        out << "  \"mode\": \"" << (parallel ? "parallel" : "serial") << "\",\n";
+        out << "  \"threads\": " << jobSystem->getConcurrency() << ",\n";
+        out << "  \"unit\": \"ms\",\n";
+        out << "  \"startup\": " << getMilliseconds() << ",\n";
+        // From process start: GLFW initialization, the job system's threads and everything before run() count too
+        out << "  \"before_startup\": " << toMilliseconds(begin - processStart) << ",\n";
+        out << "  \"time_to_first_frame\": " << toMilliseconds(firstFrame - processStart) << ",\n";
+        // What the stages would take one after the other, against startup for the overlap gained
+        out << "  \"stage_total\": " << stageTotal << ",\n";
+        out << "  \"stages\": [\n";
+        for (size_t i = 0; i < stages.size(); i++)
+        {
+            const Stage& stage = *stages[i];
+            out << "    {\"name\": \"" << stage.name << "\""
+                << ", \"start\": " << toMilliseconds(stage.begin - begin)
+                << ", \"end\": " << toMilliseconds(stage.end - begin)
+                << ", \"main_thread\": " << (stage.ranOnMainThread ? "true" : "false")
+                << "}" << (i + 1 < stages.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n";
+        out << "}\n";
+    }
+
+} // dvk
@@ -4,17 +4,18 @@
 
 #include <stdexcept>
 #include "Surface.hpp"
+#include "HostAllocator.hpp"
 
 namespace dvk {
     Surface::Surface(GLFWwindow* window, VkInstance* instance) : window(window), instance(instance) {
-        if (glfwCreateWindowSurface(*this->instance, this->window, nullptr, &surface) != VK_SUCCESS)
+        if (glfwCreateWindowSurface(*this->instance, this->window, memory::getAllocationCallbacks(), &surface) != VK_SUCCESS)
         {
             throw std::runtime_error("Failed to create surface!");
         }
     }
 
     Surface::~Surface() {
-        vkDestroySurfaceKHR(*instance, surface, nullptr);
+        vkDestroySurfaceKHR(*instance, surface, memory::getAllocationCallbacks());
     }
 
     VkSurfaceKHR *Surface::getSurface() {
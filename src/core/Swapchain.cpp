@@ -4,21 +4,23 @@
 
 #include "Swapchain.hpp"
 #include "SwapchainSupportDetails.hpp"
-#include "QueueFamilyIndices.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
 
 namespace dvk {
 
-    dvk::Swapchain::Swapchain(GLFWwindow* window, VkSurfaceKHR* surface, VkPhysicalDevice* physicalDevice, VkDevice* device) :
+    dvk::Swapchain::Swapchain(Window* window, VkSurfaceKHR* surface, VkPhysicalDevice* physicalDevice, VkDevice* device, const QueueFamilyIndices* queueFamilyIndices) :
         window(window),
         surface(surface),
         physicalDevice(physicalDevice),
-        device(device)
+        device(device),
+        queueFamilyIndices(queueFamilyIndices)
     {
         createSwapChain();
     }
 
     dvk::Swapchain::~Swapchain() {
-        vkDestroySwapchainKHR(*device, swapChain, nullptr);
+        getDeviceDispatch().vkDestroySwapchainKHR(*device, swapChain, memory::getAllocationCallbacks());
     }
 
     VkSurfaceFormatKHR Swapchain::chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats)
@@ -33,6 +35,14 @@ namespace dvk {
 
         return availableFormats[0];
     }
+
+    VkFormat Swapchain::chooseImageFormat(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface)
+    {
+        SwapchainSupportDetails swapChainSupport;
+        swapChainSupport.querySwapChainSupportDetails(physicalDevice, surface);
+        return chooseSwapSurfaceFormat(swapChainSupport.formats).format;
+    }
+
     VkPresentModeKHR Swapchain::chooseSwapPresentMode(const std::vector<VkPresentModeKHR> availablePresentModes)
     {
         for (const auto& availablePresentMode : availablePresentModes)
@@ -52,13 +62,9 @@ namespace dvk {
             return capabilities.currentExtent;
         }
         else {
-            int width, height;
-            glfwGetFramebufferSize(window, &width, &height);
-
-            VkExtent2D actualExtent = {
-                    static_cast<uint32_t>(width),
-                    static_cast<uint32_t>(height)
-            };
+            // Created on the render thread, the size comes from the window rather than from GLFW
+            VkExtent2D actualExtent{};
+            window->getFramebufferSize(actualExtent.width, actualExtent.height);
 
             actualExtent.width = std::clamp(actualExtent.width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
             actualExtent.height = std::clamp(actualExtent.height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
@@ -95,15 +101,25 @@ namespace dvk {
         createInfo.imageColorSpace = surfaceFormat.colorSpace;
         createInfo.imageArrayLayers = 1;
         createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        // Dynamic resolution blits the scene into the swapchain image
+        if (swapChainSupport.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT)
+        {
+            createInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        }
+        // Frame readback copies from it
+        if (swapChainSupport.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
+        {
+            createInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        }
+        imageUsage = createInfo.imageUsage;
 
-        QueueFamilyIndices indices(physicalDevice, surface);
-        uint32_t queueFamilyIndices[] = {indices.getGraphicsFamilyValue(), indices.getPresentationFamilyValue()};
+        uint32_t sharingFamilies[] = {queueFamilyIndices->getGraphicsFamilyValue(), queueFamilyIndices->getPresentationFamilyValue()};
 
-        if (indices.getGraphicsFamilyValue() != indices.getPresentationFamilyValue())
+        if (sharingFamilies[0] != sharingFamilies[1])
         {
             createInfo.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
             createInfo.queueFamilyIndexCount = 2;
-            createInfo.pQueueFamilyIndices = queueFamilyIndices;
+            createInfo.pQueueFamilyIndices = sharingFamilies;
         }
         else {
             createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
@@ -116,14 +132,14 @@ namespace dvk {
         createInfo.clipped = VK_TRUE;
         createInfo.oldSwapchain = VK_NULL_HANDLE;
 
-        if (vkCreateSwapchainKHR(*device, &createInfo, nullptr, &swapChain) != VK_SUCCESS)
+        if (getDeviceDispatch().vkCreateSwapchainKHR(*device, &createInfo, memory::getAllocationCallbacks(), &swapChain) != VK_SUCCESS)
         {
             throw std::runtime_error("Failed to	create swapchain!");
         }
 
-        vkGetSwapchainImagesKHR(*device, swapChain, &imageCount, nullptr);
+        getDeviceDispatch().vkGetSwapchainImagesKHR(*device, swapChain, &imageCount, nullptr);
         swapChainImages.resize(imageCount);
-        vkGetSwapchainImagesKHR(*device, swapChain, &imageCount, swapChainImages.data());
+        getDeviceDispatch().vkGetSwapchainImagesKHR(*device, swapChain, &imageCount, swapChainImages.data());
     }
 
     std::vector<VkImage> *Swapchain::getSwapchainImages() {
@@ -138,6 +154,10 @@ namespace dvk {
         return &swapChainExtent;
     }
 
+    VkImageUsageFlags Swapchain::getImageUsage() const {
+        return imageUsage;
+    }
+
     VkSwapchainKHR* Swapchain::getSwapChain() {
         return &swapChain;
     }
@@ -4,6 +4,8 @@
 
 #include <stdexcept>
 #include "SwapchainImageViews.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
 
 namespace dvk {
 
@@ -18,7 +20,7 @@ namespace dvk {
     SwapchainImageViews::~SwapchainImageViews() {
         for (auto imageView : swapChainImageViews)
         {
-            vkDestroyImageView(*device, imageView, nullptr);
+            getDeviceDispatch().vkDestroyImageView(*device, imageView, memory::getAllocationCallbacks());
         }
     }
 
@@ -44,7 +46,7 @@ namespace dvk {
             createInfo.subresourceRange.layerCount = 1;
             createInfo.subresourceRange.baseArrayLayer = 0;
 
-            if (vkCreateImageView(*device, &createInfo, nullptr, &swapChainImageViews[i]) != VK_SUCCESS)
+            if (getDeviceDispatch().vkCreateImageView(*device, &createInfo, memory::getAllocationCallbacks(), &swapChainImageViews[i]) != VK_SUCCESS)
             {
                 throw std::runtime_error("Failed to create image views");
             }
@@ -5,6 +5,8 @@
 #include <vulkan/vulkan_core.h>
 #include <stdexcept>
 #include "Synchronization.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
 
 namespace dvk {
     Synchronization::Synchronization(VkDevice* device, std::vector<VkImage>* swapchainImages, VkQueue* graphicsQueue, const int MAX_FRAMES_IN_FLIGHT) :
@@ -17,12 +19,12 @@ namespace dvk {
     }
 
     Synchronization::~Synchronization() {
-        vkQueueWaitIdle(*graphicsQueue);
+        getDeviceDispatch().vkQueueWaitIdle(*graphicsQueue);
         for(size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
         {
-            vkDestroySemaphore(*device, renderFinishedSemaphores[i], nullptr);
-            vkDestroySemaphore(*device, imageAvailableSemaphores[i], nullptr);
-            vkDestroyFence(*device, inFlightFences[i], nullptr);
+            getDeviceDispatch().vkDestroySemaphore(*device, renderFinishedSemaphores[i], memory::getAllocationCallbacks());
+            getDeviceDispatch().vkDestroySemaphore(*device, imageAvailableSemaphores[i], memory::getAllocationCallbacks());
+            getDeviceDispatch().vkDestroyFence(*device, inFlightFences[i], memory::getAllocationCallbacks());
         }
     }
 
@@ -42,9 +44,9 @@ namespace dvk {
 
         for(size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
         {
-            if (vkCreateSemaphore(*device, &semaphoreInfos, nullptr, &imageAvailableSemaphores[i]) != VK_SUCCESS ||
-                vkCreateSemaphore(*device, &semaphoreInfos, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS	||
-                vkCreateFence(*device, &fenceInfos, nullptr, &inFlightFences[i]) != VK_SUCCESS){
+            if (getDeviceDispatch().vkCreateSemaphore(*device, &semaphoreInfos, memory::getAllocationCallbacks(), &imageAvailableSemaphores[i]) != VK_SUCCESS ||
+                getDeviceDispatch().vkCreateSemaphore(*device, &semaphoreInfos, memory::getAllocationCallbacks(), &renderFinishedSemaphores[i]) != VK_SUCCESS	||
+                getDeviceDispatch().vkCreateFence(*device, &fenceInfos, memory::getAllocationCallbacks(), &inFlightFences[i]) != VK_SUCCESS){
                 throw std::runtime_error("Failed to create syncronization objects for a frame!");
             }
         }
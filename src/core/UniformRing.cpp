@@ -0,0 +1,193 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <stdexcept>
+#include "UniformRing.hpp"
+#include "MemoryUtils.hpp"
+#include "Metrics.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
+
+namespace dvk {
+    UniformRing::UniformRing(VkPhysicalDevice* physicalDevice, VkDevice* device, uint32_t framesInFlight, VkDeviceSize capacity, VkDeviceSize blockSize) :
+        physicalDevice(physicalDevice),
+        device(device),
+        capacity(capacity),
+        blockSize(blockSize),
+        frames(framesInFlight)
+    {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(*physicalDevice, &properties);
+        alignment = properties.limits.minUniformBufferOffsetAlignment;
+        if (blockSize > properties.limits.maxUniformBufferRange || blockSize > capacity)
+        {
+            throw std::runtime_error("Uniform ring block size exceeds the uniform buffer range!");
+        }
+
+        createBuffers();
+        createDescriptors();
+    }
+
+    UniformRing::~UniformRing() {
+        getDeviceDispatch().vkDestroyDescriptorPool(*device, descriptorPool, memory::getAllocationCallbacks());
+        getDeviceDispatch().vkDestroyDescriptorSetLayout(*device, descriptorSetLayout, memory::getAllocationCallbacks());
+
+        for (auto& frame : frames)
+        {
+            getDeviceDispatch().vkUnmapMemory(*device, frame.memory);
+            getDeviceDispatch().vkDestroyBuffer(*device, frame.buffer, memory::getAllocationCallbacks());
+            getDeviceDispatch().vkFreeMemory(*device, frame.memory, memory::getAllocationCallbacks());
+            metrics::getRendererMetrics().onDeviceFree();
+        }
+    }
+
+    void UniformRing::createBuffers()
+    {
+        for (auto& frame : frames)
+        {
+            VkBufferCreateInfo bufferInfo{};
+            bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            bufferInfo.size = capacity;
+            bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+            bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+            if (getDeviceDispatch().vkCreateBuffer(*device, &bufferInfo, memory::getAllocationCallbacks(), &frame.buffer) != VK_SUCCESS)
+            {
+                throw std::runtime_error("Failed to create uniform ring buffer!");
+            }
+
+            VkMemoryRequirements memRequirements;
+            getDeviceDispatch().vkGetBufferMemoryRequirements(*device, frame.buffer, &memRequirements);
+
+            uint32_t memoryType;
+            if (!utils::tryFindMemoryType(
+                    *physicalDevice,
+                    memRequirements.memoryTypeBits,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                    memoryType))
+            {
+                memoryType = utils::findMemoryType(
+                        *physicalDevice,
+                        memRequirements.memoryTypeBits,
+                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                );
+            }
+
+            VkMemoryAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            allocInfo.allocationSize = memRequirements.size;
+            allocInfo.memoryTypeIndex = memoryType;
+
+            if (getDeviceDispatch().vkAllocateMemory(*device, &allocInfo, memory::getAllocationCallbacks(), &frame.memory) != VK_SUCCESS)
+            {
+                throw std::runtime_error("Failed to allocate uniform ring memory!");
+            }
+            metrics::getRendererMetrics().onDeviceAllocation();
+
+            getDeviceDispatch().vkBindBufferMemory(*device, frame.buffer, frame.memory, 0);
+
+            void* data;
+            if (getDeviceDispatch().vkMapMemory(*device, frame.memory, 0, capacity, 0, &data) != VK_SUCCESS)
+            {
+                throw std::runtime_error("Failed to map uniform ring memory!");
+            }
+            frame.mapped = static_cast<char*>(data);
+        }
+    }
+
+    void UniformRing::createDescriptors()
+    {
+        VkDescriptorSetLayoutBinding binding{};
+        binding.binding = 0;
+        binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        binding.descriptorCount = 1;
+        binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = 1;
+        layoutInfo.pBindings = &binding;
+
+        if (getDeviceDispatch().vkCreateDescriptorSetLayout(*device, &layoutInfo, memory::getAllocationCallbacks(), &descriptorSetLayout) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create uniform ring descriptor set layout!");
+        }
+
+        VkDescriptorPoolSize poolSize{};
+        poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        poolSize.descriptorCount = static_cast<uint32_t>(frames.size());
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = static_cast<uint32_t>(frames.size());
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+
+        if (getDeviceDispatch().vkCreateDescriptorPool(*device, &poolInfo, memory::getAllocationCallbacks(), &descriptorPool) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create uniform ring descriptor pool!");
+        }
+
+        for (auto& frame : frames)
+        {
+            VkDescriptorSetAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocInfo.descriptorPool = descriptorPool;
+            allocInfo.descriptorSetCount = 1;
+            allocInfo.pSetLayouts = &descriptorSetLayout;
+
+            if (getDeviceDispatch().vkAllocateDescriptorSets(*device, &allocInfo, &frame.descriptorSet) != VK_SUCCESS)
+            {
+                throw std::runtime_error("Failed to allocate uniform ring descriptor set!");
+            }
+
+            VkDescriptorBufferInfo bufferInfo{};
+            bufferInfo.buffer = frame.buffer;
+            bufferInfo.offset = 0;
+            bufferInfo.range = blockSize;
+
+            VkWriteDescriptorSet write{};
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = frame.descriptorSet;
+            write.dstBinding = 0;
+            write.descriptorCount = 1;
+            write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+            write.pBufferInfo = &bufferInfo;
+
+            getDeviceDispatch().vkUpdateDescriptorSets(*device, 1, &write, 0, nullptr);
+        }
+    }
+
+    void UniformRing::beginFrame(uint32_t frame) {
+        frames[frame].head = 0;
+    }
+
+    void* UniformRing::allocate(uint32_t frame, VkDeviceSize size, uint32_t& offset)
+    {
+        FrameBuffer& buffer = frames[frame];
+        VkDeviceSize start = (buffer.head + alignment - 1) & ~(alignment - 1);
+        // The descriptor reads blockSize bytes from the offset, they must stay inside the buffer
+        if (size > blockSize || start + blockSize > capacity)
+        {
+            throw std::runtime_error("Uniform ring exhausted!");
+        }
+
+        buffer.head = start + size;
+        offset = static_cast<uint32_t>(start);
+        metrics::getRendererMetrics().uploadedBytes.add(size);
+        return buffer.mapped + start;
+    }
+
+    void UniformRing::bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t frame, uint32_t offset) {
+        getDeviceDispatch().vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, DRAW_UNIFORMS_SET, 1, &frames[frame].descriptorSet, 1, &offset);
+    }
+
+    VkDescriptorSetLayout *UniformRing::getDescriptorSetLayout() {
+        return &descriptorSetLayout;
+    }
+
+    VkDeviceSize UniformRing::getAlignment() const {
+        return alignment;
+    }
+} // dvk
@@ -3,16 +3,20 @@
 //
 
 #include "VertexBuffer.hpp"
-#include "QueueFamilyIndices.hpp"
+#include "Trace.hpp"
+#include "Metrics.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
 
 #include <utility>
 
 namespace dvk {
-    VertexBuffer::VertexBuffer(VkDevice* device, VkPhysicalDevice* physicalDevice, VkQueue* graphicsQueue, VkSurfaceKHR* surface) :
+    VertexBuffer::VertexBuffer(VkDevice* device, VkPhysicalDevice* physicalDevice, VkQueue* graphicsQueue, const QueueFamilyIndices* queueFamilyIndices, ResourcePools* resourcePools) :
         device(device),
         physicalDevice(physicalDevice),
         graphicsQueue(graphicsQueue),
-        surface(surface)
+        queueFamilyIndices(queueFamilyIndices),
+        resourcePools(resourcePools)
     {
         vertices = {
                 {{-0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}},
@@ -25,19 +29,24 @@ namespace dvk {
         createVertexBuffer();
     }
 
-    VertexBuffer::VertexBuffer(VkDevice* device, VkPhysicalDevice* physicalDevice, std::vector<Vertex> vertices, VkQueue* graphicsQueue, VkSurfaceKHR* surface) :
+    VertexBuffer::VertexBuffer(VkDevice* device, VkPhysicalDevice* physicalDevice, std::vector<Vertex> vertices, VkQueue* graphicsQueue, const QueueFamilyIndices* queueFamilyIndices, ResourcePools* resourcePools) :
         device(device),
         physicalDevice(physicalDevice),
         vertices(std::move(vertices)),
         graphicsQueue(graphicsQueue),
-        surface(surface)
+        queueFamilyIndices(queueFamilyIndices),
+        resourcePools(resourcePools)
     {
         createVertexBuffer();
     }
 
     VertexBuffer::~VertexBuffer() {
-        vkDestroyBuffer(*device, vertexBuffer, nullptr);
-        vkFreeMemory(*device, vertexBufferMemory, nullptr);
+        resourcePools->getMeshes()->remove(meshHandle);
+        resourcePools->getBuffers()->remove(bufferHandle);
+
+        getDeviceDispatch().vkDestroyBuffer(*device, vertexBuffer, memory::getAllocationCallbacks());
+        getDeviceDispatch().vkFreeMemory(*device, vertexBufferMemory, memory::getAllocationCallbacks());
+        metrics::getRendererMetrics().onDeviceFree();
     }
 
     void VertexBuffer::createBuffer(
@@ -53,12 +62,12 @@ namespace dvk {
         bufferInfo.usage = bufferUsageFlags;
         bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-        if (vkCreateBuffer(*device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+        if (getDeviceDispatch().vkCreateBuffer(*device, &bufferInfo, memory::getAllocationCallbacks(), &buffer) != VK_SUCCESS) {
             throw std::runtime_error("failed to create vertex buffer!");
         }
 
         VkMemoryRequirements memRequirements;
-        vkGetBufferMemoryRequirements(*device, buffer, &memRequirements);
+        getDeviceDispatch().vkGetBufferMemoryRequirements(*device, buffer, &memRequirements);
 
         VkMemoryAllocateInfo allocInfo{};
         allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
@@ -68,14 +77,16 @@ namespace dvk {
                 memoryProperties
         );
 
-        if (vkAllocateMemory(*device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
+        if (getDeviceDispatch().vkAllocateMemory(*device, &allocInfo, memory::getAllocationCallbacks(), &bufferMemory) != VK_SUCCESS) {
             throw std::runtime_error("failed to allocate vertex buffer memory!");
         }
+        metrics::getRendererMetrics().onDeviceAllocation();
 
-        vkBindBufferMemory(*device, buffer, bufferMemory, 0);
+        getDeviceDispatch().vkBindBufferMemory(*device, buffer, bufferMemory, 0);
     }
 
     void VertexBuffer::createVertexBuffer() {
+        DVK_TRACE_ZONE("createVertexBuffer");
         VkDeviceSize bufferSize = sizeof(Vertex) * this->vertices.size();
         createBuffer(
                 bufferSize,
@@ -93,22 +104,23 @@ namespace dvk {
                 vertexBufferMemory
         );
         copyBuffer(stagingBuffer, vertexBuffer, bufferSize);
+        registerResources(bufferSize);
 
         // TODO: potential memory leak, should make Buffer class into RAII
-        vkDestroyBuffer(*device, stagingBuffer, nullptr);
-        vkFreeMemory(*device, stagingBufferMemory, nullptr);
+        getDeviceDispatch().vkDestroyBuffer(*device, stagingBuffer, memory::getAllocationCallbacks());
+        getDeviceDispatch().vkFreeMemory(*device, stagingBufferMemory, memory::getAllocationCallbacks());
+        metrics::getRendererMetrics().onDeviceFree();
     }
 
     void VertexBuffer::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size) {
-        QueueFamilyIndices queueFamilyIndices(physicalDevice, surface);
-
+        DVK_TRACE_ZONE("copyBuffer");
         VkCommandPoolCreateInfo commandPoolInfos{};
         commandPoolInfos.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-        commandPoolInfos.queueFamilyIndex = queueFamilyIndices.getGraphicsFamilyValue();
+        commandPoolInfos.queueFamilyIndex = queueFamilyIndices->getGraphicsFamilyValue();
         commandPoolInfos.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
 
         VkCommandPool commandPool{};
-        if (vkCreateCommandPool(*device, &commandPoolInfos, nullptr, &commandPool) != VK_SUCCESS){
+        if (getDeviceDispatch().vkCreateCommandPool(*device, &commandPoolInfos, memory::getAllocationCallbacks(), &commandPool) != VK_SUCCESS){
             throw std::runtime_error("Failed to create command pool!");
         }
 
@@ -119,32 +131,34 @@ namespace dvk {
         allocInfo.commandBufferCount = 1;
 
         VkCommandBuffer commandBuffer;
-        vkAllocateCommandBuffers(*device, &allocInfo, &commandBuffer);
+        getDeviceDispatch().vkAllocateCommandBuffers(*device, &allocInfo, &commandBuffer);
 
         VkCommandBufferBeginInfo beginInfo{};
         beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
         beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
-        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+        getDeviceDispatch().vkBeginCommandBuffer(commandBuffer, &beginInfo);
 
         VkBufferCopy copyRegion{};
         copyRegion.srcOffset = 0;
         copyRegion.dstOffset = 0;
         copyRegion.size = size;
-        vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+        getDeviceDispatch().vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
 
-        vkEndCommandBuffer(commandBuffer);
+        getDeviceDispatch().vkEndCommandBuffer(commandBuffer);
 
         VkSubmitInfo submitInfo{};
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
         submitInfo.commandBufferCount = 1;
         submitInfo.pCommandBuffers = &commandBuffer;
 
-        vkQueueSubmit(*graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(*graphicsQueue);
+        getDeviceDispatch().vkQueueSubmit(*graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+        metrics::getRendererMetrics().queueSubmits.add();
+        metrics::getRendererMetrics().uploadedBytes.add(size);
+        getDeviceDispatch().vkQueueWaitIdle(*graphicsQueue);
 
         // TODO: Potential memory leak, turn CommandBuffer class into a generic RAII class
-        vkDestroyCommandPool(*device, commandPool, nullptr);
+        getDeviceDispatch().vkDestroyCommandPool(*device, commandPool, memory::getAllocationCallbacks());
     }
 
     uint32_t VertexBuffer::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
@@ -162,7 +176,7 @@ namespace dvk {
 
     void VertexBuffer::allocateMemory() {
         VkMemoryRequirements memRequirements;
-        vkGetBufferMemoryRequirements(*device, vertexBuffer, &memRequirements);
+        getDeviceDispatch().vkGetBufferMemoryRequirements(*device, vertexBuffer, &memRequirements);
 
         VkMemoryAllocateInfo allocInfo{};
         allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
@@ -172,18 +186,34 @@ namespace dvk {
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
                 );
 
-        if (vkAllocateMemory(*device, &allocInfo, nullptr, &vertexBufferMemory) != VK_SUCCESS) {
+        if (getDeviceDispatch().vkAllocateMemory(*device, &allocInfo, memory::getAllocationCallbacks(), &vertexBufferMemory) != VK_SUCCESS) {
             throw std::runtime_error("failed to allocate vertex buffer memory!");
         }
+        metrics::getRendererMetrics().onDeviceAllocation();
 
-        vkBindBufferMemory(*device, vertexBuffer, vertexBufferMemory, 0);
+        getDeviceDispatch().vkBindBufferMemory(*device, vertexBuffer, vertexBufferMemory, 0);
     }
 
     void VertexBuffer::fillMemory(VkDeviceSize size) {
         void* data;
-        vkMapMemory(*device, stagingBufferMemory, 0, size, 0, &data);
+        getDeviceDispatch().vkMapMemory(*device, stagingBufferMemory, 0, size, 0, &data);
         memcpy(data, vertices.data(), (size_t) size);
-        vkUnmapMemory(*device, stagingBufferMemory);
+        getDeviceDispatch().vkUnmapMemory(*device, stagingBufferMemory);
+    }
+
+    void VertexBuffer::registerResources(VkDeviceSize size)
+    {
+        bufferHandle = resourcePools->getBuffers()->insert(BufferResource{vertexBuffer, vertexBufferMemory, size});
+
+        MeshResource mesh{};
+        mesh.vertexBuffer = bufferHandle;
+        mesh.vertexCount = static_cast<uint32_t>(vertices.size());
+        mesh.firstVertex = 0;
+        meshHandle = resourcePools->getMeshes()->insert(mesh);
+    }
+
+    MeshHandle VertexBuffer::getMeshHandle() const {
+        return meshHandle;
     }
 
     VkBuffer* VertexBuffer::getVertexBuffer() {
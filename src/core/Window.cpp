@@ -12,8 +12,13 @@ namespace dvk {
         return this->window.get();
     }
 
-    Window::Window() : HEIGHT(1080), WIDTH(1920), framebufferResized(false) {
+    void Window::initGlfw() {
+        // Does nothing once GLFW is initialized
         glfwInit();
+    }
+
+    Window::Window(uint32_t width, uint32_t height) : HEIGHT(height), WIDTH(width), framebufferResized(false) {
+        initGlfw();
         createWindow(
                 std::vector<WindowHint>{
                         WindowHint{GLFW_CLIENT_API, GLFW_NO_API},
@@ -33,6 +38,30 @@ namespace dvk {
 
         glfwSetWindowUserPointer(window.get(), this);
         glfwSetFramebufferSizeCallback(window.get(), framebufferResizeCallback);
+        // Anything that can change what the window should show asks for a redraw
+        glfwSetWindowRefreshCallback(window.get(), [](GLFWwindow* raw) {
+            fromRawWindow(raw)->requestRedraw();
+        });
+        glfwSetKeyCallback(window.get(), [](GLFWwindow* raw, int key, int, int action, int) {
+            if (key == GLFW_KEY_F12 && action == GLFW_PRESS) {
+                fromRawWindow(raw)->screenshotRequested.store(true, std::memory_order_relaxed);
+            }
+            fromRawWindow(raw)->requestRedraw();
+        });
+        glfwSetMouseButtonCallback(window.get(), [](GLFWwindow* raw, int, int, int) {
+            fromRawWindow(raw)->requestRedraw();
+        });
+        glfwSetCursorPosCallback(window.get(), [](GLFWwindow* raw, double, double) {
+            fromRawWindow(raw)->requestRedraw();
+        });
+        glfwSetScrollCallback(window.get(), [](GLFWwindow* raw, double, double) {
+            fromRawWindow(raw)->requestRedraw();
+        });
+
+        int width, height;
+        glfwGetFramebufferSize(window.get(), &width, &height);
+        framebufferSize = (static_cast<uint64_t>(width) << 32) | static_cast<uint32_t>(height);
+        lastTime = glfwGetTime();
     }
 
     Window::~Window() {
@@ -48,23 +77,76 @@ namespace dvk {
         Window::framebufferResized = framebufferResized;
     }
 
+    void Window::getFramebufferSize(uint32_t& width, uint32_t& height) const {
+        uint64_t size = framebufferSize.load();
+        width = static_cast<uint32_t>(size >> 32);
+        height = static_cast<uint32_t>(size);
+    }
+
+    void Window::setGpuFrameTime(double gpuFrameTime) {
+        Window::gpuFrameTime = gpuFrameTime;
+    }
+
+    void Window::addRenderedFrame() {
+        renderedFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Window::setPaced(bool paced) {
+        this->paced = paced;
+    }
+
+    void Window::addPacingError(double pacingError) {
+        pacingErrors.fetch_add(pacingError, std::memory_order_relaxed);
+    }
+
+    void Window::requestRedraw() {
+        redrawRequested.store(true, std::memory_order_relaxed);
+    }
+
+    bool Window::consumeRedrawRequest() {
+        return redrawRequested.exchange(false, std::memory_order_relaxed);
+    }
+
+    bool Window::consumeScreenshotRequest() {
+        return screenshotRequested.exchange(false, std::memory_order_relaxed);
+    }
+
+    void Window::requestClose() {
+        glfwSetWindowShouldClose(window.get(), GLFW_TRUE);
+    }
+
+    void Window::wakeUp() {
+        glfwPostEmptyEvent();
+    }
+
+    Window* Window::fromRawWindow(GLFWwindow* window) {
+        return reinterpret_cast<Window*>(glfwGetWindowUserPointer(window));
+    }
+
     void Window::framebufferResizeCallback(GLFWwindow *window, int width, int height) {
-        auto windowInstance = reinterpret_cast<Window*>(glfwGetWindowUserPointer(window));
+        auto windowInstance = fromRawWindow(window);
+        windowInstance->framebufferSize = (static_cast<uint64_t>(width) << 32) | static_cast<uint32_t>(height);
         windowInstance->framebufferResized = true;
+        windowInstance->requestRedraw();
     }
 
     void Window::showStats() {
         // Measure speed
         double currentTime = glfwGetTime();
         double delta = currentTime - lastTime;
-        nbFrames++;
+        nbFrames += renderedFrames.exchange(0, std::memory_order_relaxed);
         if ( delta >= 1.0 ){ // If last cout was more than 1 sec ago
 //            cout << 1000.0/double(nbFrames) << endl;
 
             double fps = double(nbFrames) / delta;
-
             std::stringstream ss;
-            ss  << " [" << (1/fps) * 1000 << " ms" << " - " <<  fps << " FPS]";
+            ss  << " [" << (1/fps) * 1000 << " ms" << " - " <<  fps << " FPS" << " - GPU " << gpuFrameTime.load() << " ms";
+            if (paced) {
+                // Mean lateness of the paced frame starts
+                double pacingError = nbFrames > 0 ? pacingErrors.exchange(0.0) / nbFrames : 0.0;
+                ss << " - pacing +" << pacingError << " ms";
+            }
+            ss << "]";
 
             glfwSetWindowTitle(window.get(), ss.str().c_str());
 
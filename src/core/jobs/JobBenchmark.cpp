@@ -0,0 +1,86 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include "JobBenchmark.hpp"
+#include "JobSystem.hpp"
+
+namespace dvk::jobs {
+
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr uint32_t REPETITIONS = 5;
+    // Jobs submitted before each wait in the run() measurement, below the per-worker job ring
+    static constexpr uint32_t RUN_BATCH_SIZE = 1024;
+
+    static void emptyJob(void*, uint32_t, uint32_t)
+    {
+
+    }
+
+    // Best time of the repetitions divided by the number of jobs, in nanoseconds
+    template<typename F>
+    static double measure(uint32_t jobCount, F&& body)
+    {
+        double best = std::numeric_limits<double>::max();
+        for (uint32_t repetition = 0; repetition < REPETITIONS; repetition++)
+        {
+            auto start = Clock::now();
+            body();
+            double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            best = std::min(best, elapsed);
+        }
+        return best / jobCount;
+    }
+
+    void runJobBenchmark(uint32_t threadCount, uint32_t jobCount, std::ostream& out)
+    {
+        JobSystem jobSystem(threadCount);
+        jobCount = std::max(jobCount, 1u);
+
+        // Called through a volatile pointer so the loop cannot be folded away
+        JobFunction volatile function = emptyJob;
+        double functionCall = measure(jobCount, [&] {
+            for (uint32_t i = 0; i < jobCount; i++)
+            {
+                function(nullptr, i, i + 1);
+            }
+        });
+
+        double run = measure(jobCount, [&] {
+            for (uint32_t submitted = 0; submitted < jobCount; submitted += RUN_BATCH_SIZE)
+            {
+                JobCounter counter;
+                uint32_t batchEnd = std::min(jobCount, submitted + RUN_BATCH_SIZE);
+                for (uint32_t i = submitted; i < batchEnd; i++)
+                {
+                    jobSystem.run(emptyJob, nullptr, i, i + 1, &counter);
+                }
+                jobSystem.wait(counter);
+            }
+        });
+
+        double parallelForGrain1 = measure(jobCount, [&] {
+            jobSystem.parallelForRanges(jobCount, 1, emptyJob, nullptr);
+        });
+
+        uint32_t rangeCount = (jobCount + 63) / 64;
+        double parallelForGrain64 = measure(rangeCount, [&] {
+            jobSystem.parallelForRanges(jobCount, 64, emptyJob, nullptr);
+        });
+
+        out << "{\n";
+        out << "  \"threads\": " << jobSystem.getConcurrency() << ",\n";
+        out << "  \"jobs\": " << jobCount << ",\n";
+        out << "  \"unit\": \"ns_per_job\",\n";
+        out << "  \"function_call\": " << functionCall << ",\n";
+        out << "  \"run\": " << run << ",\n";
+        out << "  \"parallel_for_grain_1\": " << parallelForGrain1 << ",\n";
+        out << "  \"parallel_for_grain_64\": " << parallelForGrain64 << "\n";
+        out << "}\n";
+    }
+
+} // dvk
@@ -0,0 +1,280 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include "JobSystem.hpp"
+#include "AllocationCounter.hpp"
+#include "Trace.hpp"
+
+namespace dvk::jobs {
+
+    // Empty rounds an idle worker yields through before it sleeps
+    static constexpr uint32_t IDLE_SPIN_ROUNDS = 64;
+    // Ring slots a submission probes for a free job before running it inline
+    static constexpr uint32_t JOB_SLOT_PROBES = 16;
+
+    static thread_local JobSystem* currentSystem = nullptr;
+    static thread_local uint32_t currentWorker = 0;
+
+    JobSystem::JobSystem(uint32_t threadCount) :
+        previousSystem(currentSystem),
+        previousWorker(currentWorker)
+    {
+        if (threadCount == 0)
+        {
+            threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        workers.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; i++)
+        {
+            auto worker = std::make_unique<Worker>();
+            worker->jobs = std::make_unique<Job[]>(MAX_JOBS_PER_WORKER);
+            workers.push_back(std::move(worker));
+        }
+
+        currentSystem = this;
+        currentWorker = 0;
+        // Started once every worker exists, the threads steal from all of them
+        for (uint32_t i = 1; i < threadCount; i++)
+        {
+            workers[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping.store(true);
+        }
+        wakeCondition.notify_all();
+
+        for (auto& worker : workers)
+        {
+            if (worker->thread.joinable())
+            {
+                worker->thread.join();
+            }
+        }
+
+        if (currentSystem == this)
+        {
+            currentSystem = previousSystem;
+            currentWorker = previousWorker;
+        }
+    }
+
+    void JobSystem::attachThread()
+    {
+        currentSystem = this;
+        currentWorker = 0;
+    }
+
+    uint32_t JobSystem::getWorkerIndex() const
+    {
+        if (currentSystem != this)
+        {
+            throw std::runtime_error("Jobs can only be submitted from the job system's own threads!");
+        }
+        return currentWorker;
+    }
+
+    Job* JobSystem::allocateJob(Worker& worker)
+    {
+        // Jobs mostly finish in submission order, so the slot after the last one is almost always free.
+        // When it is not the ring is likely full, rather than scanning all of it the job runs inline.
+        for (uint32_t i = 0; i < JOB_SLOT_PROBES; i++)
+        {
+            Job& job = worker.jobs[worker.nextJob];
+            worker.nextJob = (worker.nextJob + 1) & (MAX_JOBS_PER_WORKER - 1);
+            if (!job.inUse.load(std::memory_order_acquire))
+            {
+                job.inUse.store(true, std::memory_order_relaxed);
+                return &job;
+            }
+        }
+        return nullptr;
+    }
+
+    Job* JobSystem::findJob(uint32_t workerIndex)
+    {
+        Job* job = workers[workerIndex]->deque.pop();
+        if (job == nullptr)
+        {
+            auto workerCount = static_cast<uint32_t>(workers.size());
+            for (uint32_t i = 1; i < workerCount && job == nullptr; i++)
+            {
+                job = workers[(workerIndex + i) % workerCount]->deque.steal();
+            }
+        }
+
+        if (job != nullptr)
+        {
+            pendingJobs.fetch_sub(1);
+        }
+        return job;
+    }
+
+    void JobSystem::execute(Job* job)
+    {
+        JobFunction function = job->function;
+        void* context = job->context;
+        uint32_t begin = job->begin;
+        uint32_t end = job->end;
+        JobCounter* counter = job->counter;
+        job->inUse.store(false, std::memory_order_release);
+
+        function(context, begin, end);
+
+        if (counter != nullptr)
+        {
+            counter->value.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    void JobSystem::workerLoop(uint32_t workerIndex)
+    {
+        currentSystem = this;
+        currentWorker = workerIndex;
+        std::string threadName = "jobs " + std::to_string(workerIndex);
+        DVK_TRACE_THREAD_NAME(threadName.c_str());
+        // Jobs are part of the frames that submit them
+        memory::countThreadAllocations();
+
+        uint32_t idleRounds = 0;
+        while (!stopping.load(std::memory_order_relaxed))
+        {
+            Job* job = findJob(workerIndex);
+            if (job != nullptr)
+            {
+                execute(job);
+                idleRounds = 0;
+                continue;
+            }
+
+            if (++idleRounds < IDLE_SPIN_ROUNDS)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            idleRounds = 0;
+
+            // Counted as sleeping before the jobs are checked, a pusher either sees it and notifies under the
+            // lock or its job is already counted
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepingWorkers.fetch_add(1);
+            wakeCondition.wait(lock, [this] { return stopping.load() || pendingJobs.load() > 0; });
+            sleepingWorkers.fetch_sub(1);
+        }
+    }
+
+    void JobSystem::run(JobFunction function, void* context, uint32_t begin, uint32_t end, JobCounter* counter)
+    {
+        Worker& worker = *workers[getWorkerIndex()];
+        Job* job = workers.size() > 1 ? allocateJob(worker) : nullptr;
+        if (job == nullptr)
+        {
+            function(context, begin, end);
+            return;
+        }
+
+        job->function = function;
+        job->context = context;
+        job->begin = begin;
+        job->end = end;
+        job->counter = counter;
+        if (counter != nullptr)
+        {
+            counter->value.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        pendingJobs.fetch_add(1);
+        if (!worker.deque.push(job))
+        {
+            pendingJobs.fetch_sub(1);
+            execute(job);
+            return;
+        }
+
+        if (sleepingWorkers.load() > 0)
+        {
+            // Taking the lock orders the notification after a sleeper's check of pendingJobs
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+            }
+            wakeCondition.notify_one();
+        }
+    }
+
+    void JobSystem::wait(JobCounter& counter)
+    {
+        uint32_t workerIndex = getWorkerIndex();
+        while (counter.value.load(std::memory_order_acquire) != 0)
+        {
+            Job* job = findJob(workerIndex);
+            if (job != nullptr)
+            {
+                execute(job);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    bool JobSystem::tryRunJob()
+    {
+        Job* job = findJob(getWorkerIndex());
+        if (job == nullptr)
+        {
+            return false;
+        }
+
+        execute(job);
+        return true;
+    }
+
+    void JobSystem::parallelForRanges(uint32_t count, uint32_t grain, JobFunction function, void* context)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        grain = std::max(grain, 1u);
+
+        // The caller keeps the first range for itself, the others are pushed last first so that the ones it pops
+        // back while waiting are the nearest, thieves take the farthest
+        JobCounter counter;
+        uint32_t firstEnd = std::min(count, grain);
+        uint32_t rangeCount = (count - firstEnd + grain - 1) / grain;
+        for (uint32_t range = rangeCount; range > 0; range--)
+        {
+            uint32_t begin = firstEnd + (range - 1) * grain;
+            run(function, context, begin, std::min(count, begin + grain), &counter);
+        }
+
+        function(context, 0, firstEnd);
+        wait(counter);
+    }
+
+    uint32_t JobSystem::getConcurrency() const {
+        return static_cast<uint32_t>(workers.size());
+    }
+
+    void JobSystem::parallelFor(uint32_t taskCount, TaskFunction task)
+    {
+        parallelForRanges(taskCount, 1, [](void* context, uint32_t begin, uint32_t end) {
+            const TaskFunction& function = *static_cast<TaskFunction*>(context);
+            for (uint32_t i = begin; i < end; i++)
+            {
+                function(i);
+            }
+        }, &task);
+    }
+
+} // dvk
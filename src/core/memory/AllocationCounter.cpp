@@ -0,0 +1,100 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "AllocationCounter.hpp"
+
+namespace dvk::memory {
+
+    // Shared by the counted threads, so allocations made by the jobs a frame fans out to are counted too
+    static std::atomic<uint64_t> allocationCount{0};
+    static thread_local bool countedThread = false;
+
+    bool isAllocationCountingEnabled() {
+#ifdef DVK_COUNT_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void countThreadAllocations() {
+        countedThread = true;
+    }
+
+    uint64_t getAllocationCount() {
+        return allocationCount.load(std::memory_order_relaxed);
+    }
+
+#ifdef DVK_COUNT_ALLOCATIONS
+    static void* countedAllocate(std::size_t size) noexcept
+    {
+        if (countedThread)
+        {
+            allocationCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    static void* countedAllocate(std::size_t size, std::align_val_t alignment) noexcept
+    {
+        if (countedThread)
+        {
+            allocationCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        auto align = static_cast<std::size_t>(alignment);
+        // aligned_alloc wants a size that is a multiple of the alignment
+        size = ((size == 0 ? 1 : size) + align - 1) & ~(align - 1);
+        return std::aligned_alloc(align, size);
+    }
+
+    static void* countedAllocateOrThrow(std::size_t size)
+    {
+        void* memory = countedAllocate(size);
+        if (memory == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    static void* countedAllocateOrThrow(std::size_t size, std::align_val_t alignment)
+    {
+        void* memory = countedAllocate(size, alignment);
+        if (memory == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+#endif
+
+} // dvk
+
+#ifdef DVK_COUNT_ALLOCATIONS
+// Every replaceable form is overridden, so each delete matches the malloc family its new came from
+void* operator new(std::size_t size) { return dvk::memory::countedAllocateOrThrow(size); }
+void* operator new[](std::size_t size) { return dvk::memory::countedAllocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return dvk::memory::countedAllocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return dvk::memory::countedAllocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return dvk::memory::countedAllocateOrThrow(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return dvk::memory::countedAllocateOrThrow(size, alignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return dvk::memory::countedAllocate(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return dvk::memory::countedAllocate(size, alignment); }
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { std::free(memory); }
+#endif
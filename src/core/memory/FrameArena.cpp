@@ -0,0 +1,83 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <algorithm>
+#include "FrameArena.hpp"
+
+namespace dvk::memory {
+
+    LinearArena::LinearArena(size_t capacity) :
+        memory(std::make_unique<std::byte[]>(capacity)),
+        capacity(capacity)
+    {
+
+    }
+
+    void LinearArena::reset() {
+        highWater = std::max(highWater, offset);
+        offset = 0;
+    }
+
+    size_t LinearArena::getUsed() const {
+        return offset;
+    }
+
+    size_t LinearArena::getCapacity() const {
+        return capacity;
+    }
+
+    size_t LinearArena::getHighWater() const {
+        return std::max(highWater, offset);
+    }
+
+    FrameArenas::FrameArenas(uint32_t framesInFlight, uint32_t threadCount, size_t capacityPerThread) :
+        framesInFlight(framesInFlight),
+        threadCount(threadCount),
+        retireValues(framesInFlight, 0)
+    {
+        arenas.reserve(framesInFlight * threadCount);
+        for (uint32_t i = 0; i < framesInFlight * threadCount; i++)
+        {
+            arenas.emplace_back(capacityPerThread);
+        }
+    }
+
+    void FrameArenas::resetFrame(uint32_t frame)
+    {
+        for (uint32_t thread = 0; thread < threadCount; thread++)
+        {
+            arenas[frame * threadCount + thread].reset();
+        }
+        retireValues[frame] = 0;
+    }
+
+    LinearArena& FrameArenas::beginFrame(uint32_t frame) {
+        resetFrame(frame);
+        return getArena(frame);
+    }
+
+    LinearArena& FrameArenas::getArena(uint32_t frame, uint32_t thread) {
+        return arenas[frame * threadCount + thread];
+    }
+
+    void FrameArenas::setRetireValue(uint32_t frame, uint64_t timelineValue) {
+        retireValues[frame] = timelineValue;
+    }
+
+    void FrameArenas::retire(uint64_t completedTimelineValue)
+    {
+        for (uint32_t frame = 0; frame < framesInFlight; frame++)
+        {
+            if (retireValues[frame] != 0 && retireValues[frame] <= completedTimelineValue)
+            {
+                resetFrame(frame);
+            }
+        }
+    }
+
+    uint32_t FrameArenas::getThreadCount() const {
+        return threadCount;
+    }
+
+} // dvk
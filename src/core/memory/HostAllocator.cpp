@@ -0,0 +1,312 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+#include "HostAllocator.hpp"
+
+namespace dvk::memory {
+
+    // Command scope allocations of one thread, live only until the Vulkan command returns
+    struct CommandArena {
+        static constexpr size_t SIZE = 64 * 1024;
+
+        std::unique_ptr<std::byte[]> memory;
+        size_t offset = 0;
+        // Freed blocks are not reclaimed one by one, the arena rewinds once none is alive
+        std::atomic<uint32_t> liveAllocations{0};
+    };
+
+    // Stored right before every block handed to the driver, pfnFree and pfnReallocation only get the pointer back
+    struct AllocationHeader {
+        void* base;
+        CommandArena* arena;
+        size_t size;
+        uint32_t alignment;
+        uint32_t scope;
+    };
+
+    static thread_local CommandArena commandArena;
+
+    static size_t alignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    static AllocationHeader* getHeader(void* memory) {
+        return reinterpret_cast<AllocationHeader*>(static_cast<std::byte*>(memory) - sizeof(AllocationHeader));
+    }
+
+    static void* allocateFromArena(size_t size, size_t alignment)
+    {
+        if (commandArena.liveAllocations.load(std::memory_order_acquire) == 0)
+        {
+            commandArena.offset = 0;
+        }
+        if (!commandArena.memory)
+        {
+            commandArena.memory = std::make_unique<std::byte[]>(CommandArena::SIZE);
+        }
+
+        auto begin = reinterpret_cast<uintptr_t>(commandArena.memory.get());
+        uintptr_t memory = alignUp(begin + commandArena.offset + sizeof(AllocationHeader), alignment);
+        if (memory + size > begin + CommandArena::SIZE)
+        {
+            return nullptr;
+        }
+
+        commandArena.offset = memory + size - begin;
+        commandArena.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+
+        auto* header = getHeader(reinterpret_cast<void*>(memory));
+        header->base = nullptr;
+        header->arena = &commandArena;
+        return reinterpret_cast<void*>(memory);
+    }
+
+    static void* allocateFromHeap(size_t size, size_t alignment)
+    {
+        size_t offset = alignUp(sizeof(AllocationHeader), alignment);
+        void* base = ::operator new(offset + size, std::align_val_t(alignment), std::nothrow);
+        if (base == nullptr)
+        {
+            return nullptr;
+        }
+
+        void* memory = static_cast<std::byte*>(base) + offset;
+        auto* header = getHeader(memory);
+        header->base = base;
+        header->arena = nullptr;
+        return memory;
+    }
+
+    const char* getAllocationScopeName(VkSystemAllocationScope scope) {
+        switch (scope) {
+            case VK_SYSTEM_ALLOCATION_SCOPE_COMMAND:
+                return "command";
+            case VK_SYSTEM_ALLOCATION_SCOPE_OBJECT:
+                return "object";
+            case VK_SYSTEM_ALLOCATION_SCOPE_CACHE:
+                return "cache";
+            case VK_SYSTEM_ALLOCATION_SCOPE_DEVICE:
+                return "device";
+            case VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE:
+                return "instance";
+            default:
+                return "unknown";
+        }
+    }
+
+    HostAllocator::HostAllocator()
+    {
+        callbacks.pUserData = this;
+        callbacks.pfnAllocation = allocationCallback;
+        callbacks.pfnReallocation = reallocationCallback;
+        callbacks.pfnFree = freeCallback;
+        callbacks.pfnInternalAllocation = internalAllocationCallback;
+        callbacks.pfnInternalFree = internalFreeCallback;
+    }
+
+    void* HostAllocator::allocate(size_t size, size_t alignment, VkSystemAllocationScope scope)
+    {
+        if (size == 0)
+        {
+            return nullptr;
+        }
+
+        alignment = std::max(alignment, alignof(AllocationHeader));
+        uint32_t scopeIndex = std::min(static_cast<uint32_t>(scope), HOST_ALLOCATION_SCOPE_COUNT - 1);
+
+        void* memory = nullptr;
+        if (scope == VK_SYSTEM_ALLOCATION_SCOPE_COMMAND)
+        {
+            memory = allocateFromArena(size, alignment);
+        }
+        bool fromArena = memory != nullptr;
+        if (memory == nullptr)
+        {
+            memory = allocateFromHeap(size, alignment);
+            if (memory == nullptr)
+            {
+                return nullptr;
+            }
+        }
+
+        auto* header = getHeader(memory);
+        header->size = size;
+        header->alignment = static_cast<uint32_t>(alignment);
+        header->scope = scopeIndex;
+
+        onAllocation(scopeIndex, size, fromArena);
+        return memory;
+    }
+
+    void* HostAllocator::reallocate(void* original, size_t size, size_t alignment, VkSystemAllocationScope scope)
+    {
+        if (original == nullptr)
+        {
+            return allocate(size, alignment, scope);
+        }
+        if (size == 0)
+        {
+            free(original);
+            return nullptr;
+        }
+
+        // On failure the original block must stay valid, so it is only freed once the copy is done
+        void* memory = allocate(size, alignment, scope);
+        if (memory == nullptr)
+        {
+            return nullptr;
+        }
+        std::memcpy(memory, original, std::min(size, getHeader(original)->size));
+        free(original);
+        return memory;
+    }
+
+    void HostAllocator::free(void* memory)
+    {
+        if (memory == nullptr)
+        {
+            return;
+        }
+
+        auto* header = getHeader(memory);
+        onFree(header->scope, header->size);
+
+        if (header->arena != nullptr)
+        {
+            header->arena->liveAllocations.fetch_sub(1, std::memory_order_release);
+        }
+        else
+        {
+            ::operator delete(header->base, std::align_val_t(header->alignment));
+        }
+    }
+
+    void HostAllocator::onAllocation(uint32_t scope, size_t size, bool fromArena)
+    {
+        ScopeCounters& counters = scopes[scope];
+        counters.allocations.fetch_add(1, std::memory_order_relaxed);
+        counters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+        if (fromArena)
+        {
+            counters.arenaAllocations.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        uint64_t liveBytes = counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        uint64_t peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+        while (liveBytes > peakBytes && !counters.peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed))
+        {
+
+        }
+    }
+
+    void HostAllocator::onFree(uint32_t scope, size_t size)
+    {
+        ScopeCounters& counters = scopes[scope];
+        counters.frees.fetch_add(1, std::memory_order_relaxed);
+        counters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+        counters.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    void* HostAllocator::allocationCallback(void* userData, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+        return static_cast<HostAllocator*>(userData)->allocate(size, alignment, scope);
+    }
+
+    void* HostAllocator::reallocationCallback(void* userData, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+        return static_cast<HostAllocator*>(userData)->reallocate(original, size, alignment, scope);
+    }
+
+    void HostAllocator::freeCallback(void* userData, void* memory) {
+        static_cast<HostAllocator*>(userData)->free(memory);
+    }
+
+    void HostAllocator::internalAllocationCallback(void* userData, size_t size, VkInternalAllocationType, VkSystemAllocationScope scope) {
+        auto* allocator = static_cast<HostAllocator*>(userData);
+        uint32_t scopeIndex = std::min(static_cast<uint32_t>(scope), HOST_ALLOCATION_SCOPE_COUNT - 1);
+        allocator->scopes[scopeIndex].internalBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void HostAllocator::internalFreeCallback(void* userData, size_t size, VkInternalAllocationType, VkSystemAllocationScope scope) {
+        auto* allocator = static_cast<HostAllocator*>(userData);
+        uint32_t scopeIndex = std::min(static_cast<uint32_t>(scope), HOST_ALLOCATION_SCOPE_COUNT - 1);
+        allocator->scopes[scopeIndex].internalBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    const VkAllocationCallbacks* HostAllocator::getCallbacks() const {
+        return &callbacks;
+    }
+
+    HostScopeStats HostAllocator::getStats(VkSystemAllocationScope scope) const
+    {
+        const ScopeCounters& counters = scopes[std::min(static_cast<uint32_t>(scope), HOST_ALLOCATION_SCOPE_COUNT - 1)];
+
+        HostScopeStats stats{};
+        stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+        stats.frees = counters.frees.load(std::memory_order_relaxed);
+        stats.arenaAllocations = counters.arenaAllocations.load(std::memory_order_relaxed);
+        stats.liveAllocations = counters.liveAllocations.load(std::memory_order_relaxed);
+        stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+        stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+        stats.internalBytes = counters.internalBytes.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    bool HostAllocator::hasLeaks() const
+    {
+        for (uint32_t scope = 0; scope < HOST_ALLOCATION_SCOPE_COUNT; scope++)
+        {
+            if (scopes[scope].liveAllocations.load(std::memory_order_relaxed) != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void HostAllocator::writeReport(std::ostream& out) const
+    {
+        out << "scope,allocations,frees,arena_allocations,live_allocations,live_bytes,peak_bytes,internal_bytes\n";
+        for (uint32_t scope = 0; scope < HOST_ALLOCATION_SCOPE_COUNT; scope++)
+        {
+            HostScopeStats stats = getStats(static_cast<VkSystemAllocationScope>(scope));
+            out << getAllocationScopeName(static_cast<VkSystemAllocationScope>(scope)) << ","
+                << stats.allocations << ","
+                << stats.frees << ","
+                << stats.arenaAllocations << ","
+                << stats.liveAllocations << ","
+                << stats.liveBytes << ","
+                << stats.peakBytes << ","
+                << stats.internalBytes << "\n";
+        }
+
+        for (uint32_t scope = 0; scope < HOST_ALLOCATION_SCOPE_COUNT; scope++)
+        {
+            HostScopeStats stats = getStats(static_cast<VkSystemAllocationScope>(scope));
+            if (stats.liveAllocations != 0)
+            {
+                out << "Leaked " << stats.liveAllocations << " host allocations (" << stats.liveBytes << " bytes) in "
+                    << getAllocationScopeName(static_cast<VkSystemAllocationScope>(scope)) << " scope\n";
+            }
+        }
+    }
+
+    HostAllocator& getHostAllocator() {
+        static HostAllocator hostAllocator;
+        return hostAllocator;
+    }
+
+    static const VkAllocationCallbacks* allocationCallbacks = getHostAllocator().getCallbacks();
+
+    const VkAllocationCallbacks* getAllocationCallbacks() {
+        return allocationCallbacks;
+    }
+
+    void setAllocationCallbacks(const VkAllocationCallbacks* callbacks) {
+        allocationCallbacks = callbacks;
+    }
+
+} // dvk
@@ -0,0 +1,43 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include "ApiCallCounter.hpp"
+
+namespace dvk {
+
+    const char* getApiCallName(ApiCall call)
+    {
+        switch (call) {
+#define DVK_API_CALL_NAME(name, timed) case ApiCall::name: return #name;
+            DVK_DEVICE_ENTRY_POINTS(DVK_API_CALL_NAME)
+#undef DVK_API_CALL_NAME
+            default:
+                return "unknown";
+        }
+    }
+
+    void ApiCallCounter::setEnabled(bool enabled) {
+        this->enabled = enabled;
+    }
+
+    bool ApiCallCounter::isEnabled() const {
+        return enabled;
+    }
+
+    void ApiCallCounter::endFrame(ApiFrameCalls& frame)
+    {
+        frame.valid = enabled;
+        for (size_t i = 0; i < API_CALL_COUNT; i++)
+        {
+            frame.calls[i] = static_cast<uint32_t>(calls[i].exchange(0, std::memory_order_relaxed));
+            frame.milliseconds[i] = static_cast<double>(nanoseconds[i].exchange(0, std::memory_order_relaxed)) / 1.0e6;
+        }
+    }
+
+    ApiCallCounter& getApiCallCounter() {
+        static ApiCallCounter counter;
+        return counter;
+    }
+
+} // dvk
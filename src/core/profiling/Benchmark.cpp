@@ -0,0 +1,368 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "Benchmark.hpp"
+
+namespace dvk {
+
+    Benchmark::Benchmark(uint32_t warmupFrames, uint32_t measuredFrames, bool paced) :
+        warmupFrames(warmupFrames),
+        measuredFrames(measuredFrames),
+        paced(paced)
+    {
+        samples.reserve(measuredFrames);
+    }
+
+    void Benchmark::recordFrame(const FrameTimings& timings)
+    {
+        if (isComplete())
+        {
+            return;
+        }
+
+        if (recordedFrames >= warmupFrames)
+        {
+            samples.push_back(timings);
+        }
+        recordedFrames++;
+    }
+
+    void Benchmark::setStartupApiCalls(const ApiFrameCalls& calls) {
+        startupApiCalls = calls;
+    }
+
+    bool Benchmark::isComplete() const {
+        return recordedFrames >= getTotalFrames();
+    }
+
+    uint32_t Benchmark::getTotalFrames() const {
+        return warmupFrames + measuredFrames;
+    }
+
+    SampleSummary Benchmark::summarize(std::vector<double>& values)
+    {
+        SampleSummary summary{};
+        summary.count = values.size();
+        if (values.empty())
+        {
+            return summary;
+        }
+
+        std::sort(values.begin(), values.end());
+
+        // Nearest-rank percentile
+        auto percentile = [&values](double p) {
+            auto rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(values.size())));
+            return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+        };
+
+        double sum = 0.0;
+        for (double value : values)
+        {
+            sum += value;
+        }
+
+        summary.min = values.front();
+        summary.max = values.back();
+        summary.mean = sum / static_cast<double>(values.size());
+        summary.p50 = percentile(50.0);
+        summary.p95 = percentile(95.0);
+        summary.p99 = percentile(99.0);
+        return summary;
+    }
+
+    std::vector<Benchmark::ReportRow> Benchmark::buildCpuRows() const
+    {
+        std::vector<ReportRow> rows;
+        std::vector<double> values;
+        values.reserve(samples.size());
+
+        for (size_t phase = 0; phase < FRAME_PHASE_COUNT; phase++)
+        {
+            values.clear();
+            for (const auto& sample : samples)
+            {
+                values.push_back(sample.phases[phase]);
+            }
+            rows.push_back({getFramePhaseName(static_cast<FramePhase>(phase)), summarize(values)});
+        }
+
+        values.clear();
+        for (const auto& sample : samples)
+        {
+            values.push_back(sample.total);
+        }
+        rows.push_back({"frame", summarize(values)});
+
+        if (paced)
+        {
+            values.clear();
+            for (const auto& sample : samples)
+            {
+                values.push_back(sample.pacingError);
+            }
+            rows.push_back({"pacing_error", summarize(values)});
+        }
+
+        return rows;
+    }
+
+    std::vector<Benchmark::ReportRow> Benchmark::buildGpuRows() const
+    {
+        std::vector<ReportRow> rows;
+        std::vector<double> values;
+        values.reserve(samples.size());
+
+        const FrameTimings* reference = nullptr;
+        for (const auto& sample : samples)
+        {
+            if (sample.gpu.valid)
+            {
+                reference = &sample;
+                break;
+            }
+        }
+        if (reference == nullptr)
+        {
+            return rows;
+        }
+
+        for (const auto& sample : samples)
+        {
+            if (sample.gpu.valid)
+            {
+                values.push_back(sample.gpu.total);
+            }
+        }
+        rows.push_back({"total", summarize(values)});
+
+        // Scopes are matched by position, the recorder emits the same scopes every frame
+        for (uint32_t scope = 0; scope < reference->gpu.scopeCount; scope++)
+        {
+            values.clear();
+            for (const auto& sample : samples)
+            {
+                if (sample.gpu.valid && scope < sample.gpu.scopeCount)
+                {
+                    values.push_back(sample.gpu.scopes[scope]);
+                }
+            }
+            rows.push_back({reference->gpu.scopeNames[scope], summarize(values)});
+        }
+
+        return rows;
+    }
+
+    bool Benchmark::hasApiCalls() const {
+        return !samples.empty() && samples.front().api.valid;
+    }
+
+    std::vector<Benchmark::ReportRow> Benchmark::buildApiCallRows() const
+    {
+        std::vector<ReportRow> rows;
+        std::vector<double> values;
+        values.reserve(samples.size());
+
+        for (const auto& sample : samples)
+        {
+            uint32_t total = 0;
+            for (uint32_t calls : sample.api.calls)
+            {
+                total += calls;
+            }
+            values.push_back(total);
+        }
+        rows.push_back({"total", summarize(values)});
+
+        // Entry points the measured frames never called are left out
+        for (size_t call = 0; call < API_CALL_COUNT; call++)
+        {
+            values.clear();
+            bool called = false;
+            for (const auto& sample : samples)
+            {
+                values.push_back(sample.api.calls[call]);
+                called = called || sample.api.calls[call] != 0;
+            }
+            if (called)
+            {
+                rows.push_back({getApiCallName(static_cast<ApiCall>(call)), summarize(values)});
+            }
+        }
+
+        return rows;
+    }
+
+    std::vector<Benchmark::ReportRow> Benchmark::buildApiTimeRows() const
+    {
+        std::vector<ReportRow> rows;
+        std::vector<double> values;
+        values.reserve(samples.size());
+
+        for (size_t call = 0; call < API_CALL_COUNT; call++)
+        {
+            if (!isApiCallTimed(static_cast<ApiCall>(call)))
+            {
+                continue;
+            }
+
+            values.clear();
+            bool called = false;
+            for (const auto& sample : samples)
+            {
+                values.push_back(sample.api.milliseconds[call]);
+                called = called || sample.api.calls[call] != 0;
+            }
+            if (called)
+            {
+                rows.push_back({getApiCallName(static_cast<ApiCall>(call)), summarize(values)});
+            }
+        }
+
+        return rows;
+    }
+
+    std::vector<Benchmark::ReportRow> Benchmark::buildStartupApiRows(bool time) const
+    {
+        std::vector<ReportRow> rows;
+        std::vector<double> values;
+
+        // A single sample each, so that they are written like the per-frame rows
+        for (size_t call = 0; call < API_CALL_COUNT; call++)
+        {
+            if (startupApiCalls.calls[call] == 0 || (time && !isApiCallTimed(static_cast<ApiCall>(call))))
+            {
+                continue;
+            }
+
+            values.assign(1, time ? startupApiCalls.milliseconds[call] : startupApiCalls.calls[call]);
+            rows.push_back({getApiCallName(static_cast<ApiCall>(call)), summarize(values)});
+        }
+
+        return rows;
+    }
+
+    size_t Benchmark::countFrames(FrameBound bound) const
+    {
+        size_t count = 0;
+        for (const auto& sample : samples)
+        {
+            if (sample.bound == bound)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    void Benchmark::writeJsonRows(std::ostream& out, const char* key, const std::vector<ReportRow>& rows)
+    {
+        out << "  \"" << key << "\": {\n";
+        for (size_t i = 0; i < rows.size(); i++)
+        {
+            const SampleSummary& summary = rows[i].summary;
+            out << "    \"" << rows[i].name << "\": {"
+                << "\"count\": " << summary.count
+                << ", \"min\": " << summary.min
+                << ", \"mean\": " << summary.mean
+                << ", \"p50\": " << summary.p50
+                << ", \"p95\": " << summary.p95
+                << ", \"p99\": " << summary.p99
+                << ", \"max\": " << summary.max
+                << "}" << (i + 1 < rows.size() ? "," : "") << "\n";
+        }
+        out << "  },\n";
+    }
+
+    void Benchmark::writeJson(std::ostream& out) const
+    {
+        out << "{\n";
+        out << "  \"warmup_frames\": " << warmupFrames << ",\n";
+        out << "  \"measured_frames\": " << samples.size() << ",\n";
+        out << "  \"unit\": \"ms\",\n";
+        writeJsonRows(out, "phases", buildCpuRows());
+        writeJsonRows(out, "gpu", buildGpuRows());
+        if (hasApiCalls())
+        {
+            // Counts per frame, time in the timed calls per frame, then the same for startup
+            writeJsonRows(out, "api_calls", buildApiCallRows());
+            writeJsonRows(out, "api_time", buildApiTimeRows());
+            writeJsonRows(out, "startup_api_calls", buildStartupApiRows(false));
+            writeJsonRows(out, "startup_api_time", buildStartupApiRows(true));
+        }
+        out << "  \"bound\": {"
+            << "\"cpu\": " << countFrames(FrameBound::Cpu)
+            << ", \"gpu\": " << countFrames(FrameBound::Gpu)
+            << ", \"unknown\": " << countFrames(FrameBound::Unknown)
+            << "}\n";
+        out << "}\n";
+    }
+
+    void Benchmark::writeCsv(std::ostream& out) const
+    {
+        out << "metric,count,min,mean,p50,p95,p99,max\n";
+
+        auto writeRows = [&out](const char* prefix, const std::vector<ReportRow>& rows) {
+            for (const auto& row : rows)
+            {
+                const SampleSummary& summary = row.summary;
+                out << prefix << row.name << ","
+                    << summary.count << ","
+                    << summary.min << ","
+                    << summary.mean << ","
+                    << summary.p50 << ","
+                    << summary.p95 << ","
+                    << summary.p99 << ","
+                    << summary.max << "\n";
+            }
+        };
+        writeRows("cpu_", buildCpuRows());
+        writeRows("gpu_", buildGpuRows());
+        if (hasApiCalls())
+        {
+            writeRows("calls_", buildApiCallRows());
+            writeRows("api_", buildApiTimeRows());
+            writeRows("startup_calls_", buildStartupApiRows(false));
+            writeRows("startup_api_", buildStartupApiRows(true));
+        }
+
+        out << "cpu_bound_frames," << countFrames(FrameBound::Cpu) << ",,,,,,\n";
+        out << "gpu_bound_frames," << countFrames(FrameBound::Gpu) << ",,,,,,\n";
+    }
+
+    void Benchmark::writeReport(std::ostream& out, ReportFormat format) const
+    {
+        auto precision = out.precision(6);
+        auto flags = out.setf(std::ios::fixed, std::ios::floatfield);
+
+        if (format == ReportFormat::Csv)
+        {
+            writeCsv(out);
+        }
+        else
+        {
+            writeJson(out);
+        }
+
+        out.precision(precision);
+        out.flags(flags);
+    }
+
+    ReportFormat Benchmark::parseReportFormat(const std::string& format)
+    {
+        if (format == "json")
+        {
+            return ReportFormat::Json;
+        }
+        if (format == "csv")
+        {
+            return ReportFormat::Csv;
+        }
+        throw std::runtime_error("Unknown benchmark report format: " + format);
+    }
+
+} // dvk
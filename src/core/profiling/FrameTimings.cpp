@@ -0,0 +1,29 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include "FrameTimings.hpp"
+
+namespace dvk {
+
+    const char* getFramePhaseName(FramePhase phase)
+    {
+        switch (phase) {
+            case FramePhase::Wait:
+                return "wait";
+            case FramePhase::Pace:
+                return "pace";
+            case FramePhase::Acquire:
+                return "acquire";
+            case FramePhase::Record:
+                return "record";
+            case FramePhase::Submit:
+                return "submit";
+            case FramePhase::Present:
+                return "present";
+            default:
+                return "unknown";
+        }
+    }
+
+} // dvk
@@ -0,0 +1,193 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <stdexcept>
+#include <algorithm>
+#include "GpuProfiler.hpp"
+#include "Trace.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
+
+namespace dvk {
+
+    GpuProfiler::GpuProfiler(const DeviceProfile* deviceProfile, VkDevice* device, uint32_t queueFamilyIndex, uint32_t framesInFlight) :
+        deviceProfile(deviceProfile),
+        device(device),
+        framesInFlight(framesInFlight)
+    {
+        frames.resize(framesInFlight);
+        results.resize(MAX_GPU_SCOPES * 2);
+        createQueryPool(queueFamilyIndex);
+    }
+
+    GpuProfiler::~GpuProfiler() {
+        if (queryPool != VK_NULL_HANDLE)
+        {
+            getDeviceDispatch().vkDestroyQueryPool(*device, queryPool, memory::getAllocationCallbacks());
+        }
+    }
+
+    void GpuProfiler::createQueryPool(uint32_t queueFamilyIndex)
+    {
+        const VkPhysicalDeviceProperties& properties = *deviceProfile->getProperties();
+        uint32_t validBits = (*deviceProfile->getQueueFamilies())[queueFamilyIndex].timestampValidBits;
+        if (validBits == 0 || properties.limits.timestampPeriod <= 0.0f)
+        {
+            // Timestamps are not supported on this queue, the profiler records nothing
+            return;
+        }
+
+        timestampPeriod = static_cast<double>(properties.limits.timestampPeriod);
+        timestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+
+        VkQueryPoolCreateInfo queryPoolInfo{};
+        queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        queryPoolInfo.queryCount = framesInFlight * MAX_GPU_SCOPES * 2;
+
+        if (getDeviceDispatch().vkCreateQueryPool(*device, &queryPoolInfo, memory::getAllocationCallbacks(), &queryPool) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create timestamp query pool!");
+        }
+
+        // Queries start out undefined, with host resets nothing in a command buffer resets them before first use
+        hostQueryReset = deviceProfile->supportsHostQueryReset();
+        if (hostQueryReset)
+        {
+            getDeviceDispatch().vkResetQueryPool(*device, queryPool, 0, queryPoolInfo.queryCount);
+        }
+
+        supported = true;
+    }
+
+    uint32_t GpuProfiler::getFirstQuery(uint32_t frame) const {
+        return frame * MAX_GPU_SCOPES * 2;
+    }
+
+    void GpuProfiler::beginFrame(VkCommandBuffer commandBuffer, uint32_t frame)
+    {
+        if (!supported)
+        {
+            return;
+        }
+
+        // A slot that was never collected still holds its last results, it is reset on the GPU as before
+        if (!hostQueryReset || frames[frame].pending)
+        {
+            getDeviceDispatch().vkCmdResetQueryPool(commandBuffer, queryPool, getFirstQuery(frame), MAX_GPU_SCOPES * 2);
+        }
+        frames[frame].scopeCount = 0;
+        frames[frame].pending = true;
+    }
+
+    uint32_t GpuProfiler::beginScope(VkCommandBuffer commandBuffer, uint32_t frame, const char* name)
+    {
+        FrameQueries& queries = frames[frame];
+        if (!supported || queries.scopeCount >= MAX_GPU_SCOPES)
+        {
+            return MAX_GPU_SCOPES;
+        }
+
+        uint32_t scope = queries.scopeCount++;
+        queries.scopeNames[scope] = name;
+        getDeviceDispatch().vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, getFirstQuery(frame) + scope * 2);
+        return scope;
+    }
+
+    void GpuProfiler::endScope(VkCommandBuffer commandBuffer, uint32_t frame, uint32_t scope)
+    {
+        if (!supported || scope >= MAX_GPU_SCOPES)
+        {
+            return;
+        }
+
+        getDeviceDispatch().vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, getFirstQuery(frame) + scope * 2 + 1);
+    }
+
+    void GpuProfiler::markSubmitted(uint32_t frame) {
+        if (supported && trace::isEnabled())
+        {
+            frames[frame].submitTime = trace::now();
+        }
+    }
+
+    bool GpuProfiler::collect(uint32_t frame, GpuFrameTimings& timings)
+    {
+        FrameQueries& queries = frames[frame];
+        timings.valid = false;
+
+        if (!supported || !queries.pending || queries.scopeCount == 0)
+        {
+            return false;
+        }
+        queries.pending = false;
+
+        // No WAIT bit: the frame's fence has signaled, an unavailable result is dropped rather than waited for
+        VkResult result = getDeviceDispatch().vkGetQueryPoolResults(
+                *device,
+                queryPool,
+                getFirstQuery(frame),
+                queries.scopeCount * 2,
+                queries.scopeCount * 2 * sizeof(uint64_t),
+                results.data(),
+                sizeof(uint64_t),
+                VK_QUERY_RESULT_64_BIT
+                );
+        if (hostQueryReset)
+        {
+            getDeviceDispatch().vkResetQueryPool(*device, queryPool, getFirstQuery(frame), MAX_GPU_SCOPES * 2);
+        }
+        if (result != VK_SUCCESS)
+        {
+            return false;
+        }
+
+        uint64_t frameBegin = UINT64_MAX;
+        uint64_t frameEnd = 0;
+        timings.scopeCount = queries.scopeCount;
+        for (uint32_t scope = 0; scope < queries.scopeCount; scope++)
+        {
+            uint64_t begin = results[scope * 2] & timestampMask;
+            uint64_t end = results[scope * 2 + 1] & timestampMask;
+            uint64_t ticks = (end - begin) & timestampMask;
+
+            timings.scopeNames[scope] = queries.scopeNames[scope];
+            timings.scopes[scope] = static_cast<double>(ticks) * timestampPeriod / 1e6;
+
+            frameBegin = std::min(frameBegin, begin);
+            frameEnd = std::max(frameEnd, end);
+        }
+
+        timings.total = static_cast<double>((frameEnd - frameBegin) & timestampMask) * timestampPeriod / 1e6;
+        timings.valid = true;
+
+        if (trace::isEnabled())
+        {
+            writeTraceEvents(queries, frameBegin);
+        }
+        return true;
+    }
+
+    void GpuProfiler::writeTraceEvents(const FrameQueries& queries, uint64_t frameBegin)
+    {
+        // GPU ticks share no epoch with the CPU clock. The frame is placed at its submit, or right after the previous
+        // frame when the queue was still busy, so its start is approximate while the scope durations stay exact.
+        uint64_t anchor = std::max(queries.submitTime, lastTraceEnd);
+        for (uint32_t scope = 0; scope < queries.scopeCount; scope++)
+        {
+            uint64_t begin = (results[scope * 2] - frameBegin) & timestampMask;
+            uint64_t end = (results[scope * 2 + 1] - frameBegin) & timestampMask;
+            uint64_t traceBegin = anchor + static_cast<uint64_t>(static_cast<double>(begin) * timestampPeriod);
+            uint64_t traceEnd = anchor + static_cast<uint64_t>(static_cast<double>(end) * timestampPeriod);
+
+            trace::writeGpuEvent(queries.scopeNames[scope], traceBegin, traceEnd);
+            lastTraceEnd = std::max(lastTraceEnd, traceEnd);
+        }
+    }
+
+    bool GpuProfiler::isSupported() const {
+        return supported;
+    }
+
+} // dvk
@@ -0,0 +1,158 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include "Metrics.hpp"
+
+namespace dvk::metrics {
+
+    static void writeHeader(std::ostream& out, const std::string& name, const std::string& help, const char* type)
+    {
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " " << type << "\n";
+    }
+
+    Metric::Metric(std::string name, std::string help) :
+        name(std::move(name)),
+        help(std::move(help))
+    {
+
+    }
+
+    void Counter::writePrometheus(std::ostream& out) const
+    {
+        writeHeader(out, name, help, "counter");
+        out << name << " " << getValue() << "\n";
+    }
+
+    void Gauge::writePrometheus(std::ostream& out) const
+    {
+        writeHeader(out, name, help, "gauge");
+        out << name << " " << getValue() << "\n";
+    }
+
+    Histogram::Histogram(std::string name, std::string help, std::vector<double> upperBounds) :
+        Metric(std::move(name), std::move(help)),
+        upperBounds(std::move(upperBounds)),
+        buckets(std::make_unique<std::atomic<uint64_t>[]>(this->upperBounds.size() + 1))
+    {
+
+    }
+
+    void Histogram::writePrometheus(std::ostream& out) const
+    {
+        writeHeader(out, name, help, "histogram");
+
+        // Buckets are stored individually, Prometheus expects them cumulative
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < upperBounds.size(); i++)
+        {
+            cumulative += buckets[i].load(std::memory_order_relaxed);
+            out << name << "_bucket{le=\"" << upperBounds[i] << "\"} " << cumulative << "\n";
+        }
+        cumulative += buckets[upperBounds.size()].load(std::memory_order_relaxed);
+        out << name << "_bucket{le=\"+Inf\"} " << cumulative << "\n";
+        out << name << "_sum " << sum.load(std::memory_order_relaxed) << "\n";
+        out << name << "_count " << count.load(std::memory_order_relaxed) << "\n";
+    }
+
+    std::vector<double> Histogram::exponentialBounds(double start, double factor, uint32_t count)
+    {
+        std::vector<double> bounds(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            bounds[i] = start;
+            start *= factor;
+        }
+        return bounds;
+    }
+
+    Counter& Registry::addCounter(std::string name, std::string help)
+    {
+        auto counter = std::make_unique<Counter>(std::move(name), std::move(help));
+        Counter& result = *counter;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        metrics.push_back(std::move(counter));
+        return result;
+    }
+
+    Gauge& Registry::addGauge(std::string name, std::string help)
+    {
+        auto gauge = std::make_unique<Gauge>(std::move(name), std::move(help));
+        Gauge& result = *gauge;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        metrics.push_back(std::move(gauge));
+        return result;
+    }
+
+    Histogram& Registry::addHistogram(std::string name, std::string help, std::vector<double> upperBounds)
+    {
+        auto histogram = std::make_unique<Histogram>(std::move(name), std::move(help), std::move(upperBounds));
+        Histogram& result = *histogram;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        metrics.push_back(std::move(histogram));
+        return result;
+    }
+
+    void Registry::writePrometheus(std::ostream& out)
+    {
+        out.precision(10);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& metric : metrics)
+        {
+            metric->writePrometheus(out);
+        }
+    }
+
+    void Registry::writePrometheusFile(const std::string& fileName)
+    {
+        std::string temporaryFileName = fileName + ".tmp";
+        {
+            std::ofstream file(temporaryFileName);
+            if (!file.is_open())
+            {
+                throw std::runtime_error("Failed to open metrics file: " + temporaryFileName);
+            }
+            writePrometheus(file);
+        }
+        std::filesystem::rename(temporaryFileName, fileName);
+    }
+
+    RendererMetrics::RendererMetrics(Registry& registry) :
+        frames(registry.addCounter("dvk_frames_total", "Frames drawn.")),
+        drawCalls(registry.addCounter("dvk_draw_calls_total", "Draw commands recorded.")),
+        drawsPerFrame(registry.addHistogram("dvk_draws_per_frame", "Draw commands recorded per frame.", Histogram::exponentialBounds(1, 4, 8))),
+        triangles(registry.addCounter("dvk_triangles_total", "Triangles submitted in draw commands.")),
+        pipelineBinds(registry.addCounter("dvk_pipeline_binds_total", "Pipeline bind commands recorded.")),
+        skippedBinds(registry.addCounter("dvk_skipped_binds_total", "Pipeline and vertex buffer binds skipped because the state was already bound.")),
+        uploadedBytes(registry.addCounter("dvk_uploaded_bytes_total", "Bytes copied from the host to GPU buffers.")),
+        queueSubmits(registry.addCounter("dvk_queue_submits_total", "Calls to vkQueueSubmit.")),
+        deviceAllocations(registry.addCounter("dvk_device_memory_allocations_total", "Calls to vkAllocateMemory.")),
+        liveDeviceAllocations(registry.addGauge("dvk_device_memory_allocations", "Device memory allocations currently alive.")),
+        swapchainRecreations(registry.addCounter("dvk_swapchain_recreations_total", "Swapchain recreations.")),
+        swapchainRecreationSeconds(registry.addHistogram("dvk_swapchain_recreation_seconds", "Time spent recreating the swapchain.", Histogram::exponentialBounds(0.001, 2, 10))),
+        fenceWaitSeconds(registry.addHistogram("dvk_fence_wait_seconds", "Time spent waiting on the in-flight fence of a frame.", Histogram::exponentialBounds(0.0001, 2, 12))),
+        pacingErrorSeconds(registry.addHistogram("dvk_frame_pacing_error_seconds", "How late the frame pacer started a frame after its scheduled time.", Histogram::exponentialBounds(0.00001, 2, 12))),
+        resolutionScale(registry.addGauge("dvk_resolution_scale", "Fraction of the output's width and height the scene is rendered at."))
+    {
+
+    }
+
+    Registry& getRegistry() {
+        static Registry registry;
+        return registry;
+    }
+
+    RendererMetrics& getRendererMetrics() {
+        static RendererMetrics rendererMetrics(getRegistry());
+        return rendererMetrics;
+    }
+
+} // dvk
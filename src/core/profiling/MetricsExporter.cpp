@@ -0,0 +1,58 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <iostream>
+#include "MetricsExporter.hpp"
+#include "Trace.hpp"
+
+namespace dvk::metrics {
+
+    MetricsExporter::MetricsExporter(Registry& registry, std::string fileName, std::chrono::steady_clock::duration period) :
+        registry(registry),
+        fileName(std::move(fileName)),
+        period(period)
+    {
+        exportThread = std::thread(&MetricsExporter::exportLoop, this);
+    }
+
+    MetricsExporter::~MetricsExporter()
+    {
+        stop();
+    }
+
+    void MetricsExporter::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        condition.notify_one();
+        if (exportThread.joinable())
+        {
+            exportThread.join();
+        }
+    }
+
+    void MetricsExporter::exportLoop()
+    {
+        DVK_TRACE_THREAD_NAME("metrics export");
+
+        auto nextExport = std::chrono::steady_clock::now() + period;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!condition.wait_until(lock, nextExport, [this] { return stopping; }))
+        {
+            nextExport += period;
+            lock.unlock();
+            // A failed export is retried at the next period, the final one reports its error
+            try {
+                DVK_TRACE_ZONE("exportMetrics");
+                registry.writePrometheusFile(fileName);
+            } catch (const std::exception& e) {
+                std::cerr << "Metrics export: " << e.what() << '\n';
+            }
+            lock.lock();
+        }
+    }
+
+} // dvk
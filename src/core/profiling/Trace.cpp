@@ -0,0 +1,155 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "Trace.hpp"
+
+namespace dvk::trace {
+
+    using Clock = std::chrono::steady_clock;
+
+    static const Clock::time_point epoch = Clock::now();
+
+    // Buffers are owned by the registry rather than by their thread, so events of finished threads can still be exported
+    static std::mutex registryMutex;
+    static std::vector<std::unique_ptr<ThreadBuffer>> registry;
+
+    static ThreadBuffer& registerBuffer(std::string threadName)
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto threadId = static_cast<uint32_t>(registry.size());
+        registry.push_back(std::make_unique<ThreadBuffer>(threadId, std::move(threadName)));
+        return *registry.back();
+    }
+
+    static void writeEscaped(std::ostream& out, const std::string& value)
+    {
+        for (char c : value)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out << '\\';
+            }
+            out << c;
+        }
+    }
+
+    ThreadBuffer::ThreadBuffer(uint32_t threadId, std::string threadName) :
+        threadName(std::move(threadName)),
+        threadId(threadId)
+    {
+
+    }
+
+    void ThreadBuffer::setThreadName(std::string name) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        threadName = std::move(name);
+    }
+
+    bool ThreadBuffer::tryRead(uint64_t index, Event& event) const
+    {
+        const Slot& slot = slots[index & (CAPACITY - 1)];
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * index + 2)
+        {
+            return false;
+        }
+
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.begin = slot.begin.load(std::memory_order_relaxed);
+        event.end = slot.end.load(std::memory_order_relaxed);
+
+        // A newer event started in the slot while it was copied
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.sequence.load(std::memory_order_relaxed) == sequence;
+    }
+
+    void ThreadBuffer::writeChromeEvents(std::ostream& out, bool& first) const
+    {
+        out << (first ? "" : ",\n") << R"(    {"name": "thread_name", "ph": "M", "pid": 1, "tid": )" << threadId
+            << R"(, "args": {"name": ")";
+        writeEscaped(out, threadName);
+        out << "\"}}";
+        first = false;
+
+        uint64_t end = writeIndex.load(std::memory_order_acquire);
+        uint64_t begin = end > CAPACITY ? end - CAPACITY : 0;
+        for (uint64_t i = begin; i < end; i++)
+        {
+            Event event{};
+            if (!tryRead(i, event))
+            {
+                continue;
+            }
+            out << ",\n" << R"(    {"name": ")";
+            writeEscaped(out, event.name);
+            out << R"(", "ph": "X", "pid": 1, "tid": )" << threadId
+                << ", \"ts\": " << static_cast<double>(event.begin) / 1000.0
+                << ", \"dur\": " << static_cast<double>(event.end - event.begin) / 1000.0 << "}";
+        }
+    }
+
+    uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count());
+    }
+
+    bool isEnabled() {
+#ifdef DVK_ENABLE_TRACING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    ThreadBuffer& getThreadBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (buffer == nullptr)
+        {
+            buffer = &registerBuffer("thread");
+        }
+        return *buffer;
+    }
+
+    void setThreadName(const char* name) {
+        getThreadBuffer().setThreadName(name);
+    }
+
+    void writeGpuEvent(const char* name, uint64_t begin, uint64_t end) {
+        static ThreadBuffer& gpuBuffer = registerBuffer("GPU");
+        gpuBuffer.write(name, begin, end);
+    }
+
+    void writeChromeTrace(std::ostream& out)
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+
+        out.setf(std::ios::fixed, std::ios::floatfield);
+        out.precision(3);
+        out << "{\n  \"displayTimeUnit\": \"ms\",\n  \"traceEvents\": [\n";
+
+        bool first = true;
+        for (const auto& buffer : registry)
+        {
+            buffer->writeChromeEvents(out, first);
+        }
+
+        out << "\n  ]\n}\n";
+    }
+
+    void writeChromeTrace(const std::string& fileName)
+    {
+        std::ofstream file(fileName);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to open trace file: " + fileName);
+        }
+        writeChromeTrace(file);
+    }
+
+} // dvk
@@ -0,0 +1,291 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <stdexcept>
+#include <algorithm>
+#include "BindlessDescriptors.hpp"
+#include "HostAllocator.hpp"
+#include "DeviceDispatch.hpp"
+
+namespace dvk {
+
+    static constexpr std::array<VkDescriptorType, 3> BINDLESS_DESCRIPTOR_TYPES = {
+            VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            VK_DESCRIPTOR_TYPE_SAMPLER
+    };
+
+    BindlessDescriptors::BindlessDescriptors(
+            VkPhysicalDevice* physicalDevice,
+            VkDevice* device,
+            uint32_t framesInFlight,
+            uint32_t sampledImageCapacity,
+            uint32_t storageBufferCapacity,
+            uint32_t samplerCapacity
+            ) :
+        physicalDevice(physicalDevice),
+        device(device),
+        framesInFlight(framesInFlight)
+    {
+        slots[static_cast<uint32_t>(BindlessType::SampledImage)].capacity = sampledImageCapacity;
+        slots[static_cast<uint32_t>(BindlessType::StorageBuffer)].capacity = storageBufferCapacity;
+        slots[static_cast<uint32_t>(BindlessType::Sampler)].capacity = samplerCapacity;
+        for (auto& allocator : slots)
+        {
+            allocator.freeSlots.reserve(allocator.capacity);
+            allocator.retired.reserve(allocator.capacity);
+        }
+
+        clampCapacities();
+        createDescriptorSetLayout();
+        createDescriptorPool();
+        allocateDescriptorSet();
+        createPipelineLayout();
+    }
+
+    BindlessDescriptors::~BindlessDescriptors() {
+        getDeviceDispatch().vkDestroyPipelineLayout(*device, pipelineLayout, memory::getAllocationCallbacks());
+        getDeviceDispatch().vkDestroyDescriptorPool(*device, descriptorPool, memory::getAllocationCallbacks());
+        getDeviceDispatch().vkDestroyDescriptorSetLayout(*device, descriptorSetLayout, memory::getAllocationCallbacks());
+    }
+
+    void BindlessDescriptors::clampCapacities()
+    {
+        VkPhysicalDeviceVulkan12Properties properties12{};
+        properties12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+        VkPhysicalDeviceProperties2 properties{};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties.pNext = &properties12;
+        vkGetPhysicalDeviceProperties2(*physicalDevice, &properties);
+
+        auto clamp = [](SlotAllocator& allocator, uint32_t perStageLimit, uint32_t setLimit) {
+            allocator.capacity = std::min({allocator.capacity, perStageLimit, setLimit});
+        };
+        clamp(slots[static_cast<uint32_t>(BindlessType::SampledImage)],
+              properties12.maxPerStageDescriptorUpdateAfterBindSampledImages,
+              properties12.maxDescriptorSetUpdateAfterBindSampledImages);
+        clamp(slots[static_cast<uint32_t>(BindlessType::StorageBuffer)],
+              properties12.maxPerStageDescriptorUpdateAfterBindStorageBuffers,
+              properties12.maxDescriptorSetUpdateAfterBindStorageBuffers);
+        clamp(slots[static_cast<uint32_t>(BindlessType::Sampler)],
+              properties12.maxPerStageDescriptorUpdateAfterBindSamplers,
+              properties12.maxDescriptorSetUpdateAfterBindSamplers);
+    }
+
+    void BindlessDescriptors::createDescriptorSetLayout()
+    {
+        std::array<VkDescriptorSetLayoutBinding, 3> bindings{};
+        std::array<VkDescriptorBindingFlags, 3> bindingFlags{};
+        for (uint32_t i = 0; i < bindings.size(); i++)
+        {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = BINDLESS_DESCRIPTOR_TYPES[i];
+            bindings[i].descriptorCount = slots[i].capacity;
+            bindings[i].stageFlags = VK_SHADER_STAGE_ALL;
+            // Unused slots stay unwritten, written ones may change while the set is bound by frames not reading them
+            bindingFlags[i] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+                    | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+                    | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+        }
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+        bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        bindingFlagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+        bindingFlagsInfo.pBindingFlags = bindingFlags.data();
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.pNext = &bindingFlagsInfo;
+        layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        if (getDeviceDispatch().vkCreateDescriptorSetLayout(*device, &layoutInfo, memory::getAllocationCallbacks(), &descriptorSetLayout) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create bindless descriptor set layout!");
+        }
+    }
+
+    void BindlessDescriptors::createDescriptorPool()
+    {
+        std::array<VkDescriptorPoolSize, 3> poolSizes{};
+        for (uint32_t i = 0; i < poolSizes.size(); i++)
+        {
+            poolSizes[i].type = BINDLESS_DESCRIPTOR_TYPES[i];
+            poolSizes[i].descriptorCount = slots[i].capacity;
+        }
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+        poolInfo.maxSets = 1;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes = poolSizes.data();
+
+        if (getDeviceDispatch().vkCreateDescriptorPool(*device, &poolInfo, memory::getAllocationCallbacks(), &descriptorPool) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create bindless descriptor pool!");
+        }
+    }
+
+    void BindlessDescriptors::allocateDescriptorSet()
+    {
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &descriptorSetLayout;
+
+        if (getDeviceDispatch().vkAllocateDescriptorSets(*device, &allocInfo, &descriptorSet) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to allocate bindless descriptor set!");
+        }
+    }
+
+    void BindlessDescriptors::createPipelineLayout()
+    {
+        VkPushConstantRange pushConstantRange = getPushConstantRange();
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (getDeviceDispatch().vkCreatePipelineLayout(*device, &pipelineLayoutInfo, memory::getAllocationCallbacks(), &pipelineLayout) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create bindless pipeline layout!");
+        }
+    }
+
+    uint32_t BindlessDescriptors::allocateSlot(BindlessType type)
+    {
+        SlotAllocator& allocator = slots[static_cast<uint32_t>(type)];
+        if (!allocator.freeSlots.empty())
+        {
+            uint32_t slot = allocator.freeSlots.back();
+            allocator.freeSlots.pop_back();
+            return slot;
+        }
+        if (allocator.next == allocator.capacity)
+        {
+            throw std::runtime_error("Bindless descriptor array is full!");
+        }
+        return allocator.next++;
+    }
+
+    uint32_t BindlessDescriptors::addSampledImage(VkImageView imageView, VkImageLayout imageLayout)
+    {
+        uint32_t slot = allocateSlot(BindlessType::SampledImage);
+
+        VkDescriptorImageInfo imageInfo{};
+        imageInfo.imageView = imageView;
+        imageInfo.imageLayout = imageLayout;
+
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = descriptorSet;
+        write.dstBinding = static_cast<uint32_t>(BindlessType::SampledImage);
+        write.dstArrayElement = slot;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        write.pImageInfo = &imageInfo;
+
+        getDeviceDispatch().vkUpdateDescriptorSets(*device, 1, &write, 0, nullptr);
+        return slot;
+    }
+
+    uint32_t BindlessDescriptors::addStorageBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+    {
+        uint32_t slot = allocateSlot(BindlessType::StorageBuffer);
+
+        VkDescriptorBufferInfo bufferInfo{};
+        bufferInfo.buffer = buffer;
+        bufferInfo.offset = offset;
+        bufferInfo.range = range;
+
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = descriptorSet;
+        write.dstBinding = static_cast<uint32_t>(BindlessType::StorageBuffer);
+        write.dstArrayElement = slot;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        write.pBufferInfo = &bufferInfo;
+
+        getDeviceDispatch().vkUpdateDescriptorSets(*device, 1, &write, 0, nullptr);
+        return slot;
+    }
+
+    uint32_t BindlessDescriptors::addSampler(VkSampler sampler)
+    {
+        uint32_t slot = allocateSlot(BindlessType::Sampler);
+
+        VkDescriptorImageInfo imageInfo{};
+        imageInfo.sampler = sampler;
+
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = descriptorSet;
+        write.dstBinding = static_cast<uint32_t>(BindlessType::Sampler);
+        write.dstArrayElement = slot;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+        write.pImageInfo = &imageInfo;
+
+        getDeviceDispatch().vkUpdateDescriptorSets(*device, 1, &write, 0, nullptr);
+        return slot;
+    }
+
+    void BindlessDescriptors::release(BindlessType type, uint32_t slot) {
+        slots[static_cast<uint32_t>(type)].retired.emplace_back(frameNumber, slot);
+    }
+
+    void BindlessDescriptors::beginFrame()
+    {
+        frameNumber++;
+        // A slot released during frame N may be read until frame N + framesInFlight - 1 has finished
+        for (auto& allocator : slots)
+        {
+            auto firstInUse = std::partition(allocator.retired.begin(), allocator.retired.end(), [this](const auto& retired) {
+                return retired.first + framesInFlight <= frameNumber;
+            });
+            for (auto it = allocator.retired.begin(); it != firstInUse; ++it)
+            {
+                allocator.freeSlots.push_back(it->second);
+            }
+            allocator.retired.erase(allocator.retired.begin(), firstInUse);
+        }
+    }
+
+    void BindlessDescriptors::bind(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint) {
+        getDeviceDispatch().vkCmdBindDescriptorSets(commandBuffer, bindPoint, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+    }
+
+    void BindlessDescriptors::pushIndices(VkCommandBuffer commandBuffer, const BindlessIndices& indices) {
+        getDeviceDispatch().vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_ALL, 0, sizeof(BindlessIndices), &indices);
+    }
+
+    VkDescriptorSetLayout *BindlessDescriptors::getDescriptorSetLayout() {
+        return &descriptorSetLayout;
+    }
+
+    VkPipelineLayout *BindlessDescriptors::getPipelineLayout() {
+        return &pipelineLayout;
+    }
+
+    VkPushConstantRange BindlessDescriptors::getPushConstantRange() {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_ALL;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(BindlessIndices);
+        return pushConstantRange;
+    }
+
+    uint32_t BindlessDescriptors::getCapacity(BindlessType type) const {
+        return slots[static_cast<uint32_t>(type)].capacity;
+    }
+
+} // dvk
@@ -0,0 +1,25 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include "ResourcePools.hpp"
+
+namespace dvk {
+
+    SlotMap<BufferResource, BufferResource>* ResourcePools::getBuffers() {
+        return &buffers;
+    }
+
+    SlotMap<ImageResource, ImageResource>* ResourcePools::getImages() {
+        return &images;
+    }
+
+    SlotMap<PipelineResource, PipelineResource>* ResourcePools::getPipelines() {
+        return &pipelines;
+    }
+
+    SlotMap<MeshResource, MeshResource>* ResourcePools::getMeshes() {
+        return &meshes;
+    }
+
+} // dvk
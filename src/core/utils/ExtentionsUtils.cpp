@@ -7,13 +7,19 @@
 
 namespace dvk::utils {
     std::vector<const char*> deviceExtensions{ VK_KHR_SWAPCHAIN_EXTENSION_NAME };
-    std::vector<const char*> getRequiredExtensions()
+    std::vector<const char*> getRequiredExtensions(bool headless)
     {
-        uint32_t glfwExtensionCount = 0;
-        const char** glfwExtensions;
+        std::vector<const char*> extensions;
 
-        glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-        std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount); // (first, last)
+        // Headless runs never initialize GLFW and need no WSI extensions
+        if (!headless)
+        {
+            uint32_t glfwExtensionCount = 0;
+            const char** glfwExtensions;
+
+            glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+            extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount); // (first, last)
+        }
 
         if (constants::enable_Validation_Layers)
         {
@@ -41,7 +47,7 @@ namespace dvk::utils {
         }
     }
 
-    bool checkDeviceExensionsSupport(VkPhysicalDevice device)
+    bool checkDeviceExensionsSupport(VkPhysicalDevice device, const std::vector<const char*>& extensions)
     {
         uint32_t availableDeviceExtensionsCount = 0;
         vkEnumerateDeviceExtensionProperties(device, nullptr, &availableDeviceExtensionsCount, nullptr);
@@ -49,7 +55,7 @@ namespace dvk::utils {
         std::vector<VkExtensionProperties> availableDeviceExtensions(availableDeviceExtensionsCount);
         vkEnumerateDeviceExtensionProperties(device, nullptr, &availableDeviceExtensionsCount, availableDeviceExtensions.data());
 
-        std::set<std::string> requiredExtensions( deviceExtensions.begin(), deviceExtensions.end() );
+        std::set<std::string> requiredExtensions( extensions.begin(), extensions.end() );
         for (const auto& extension : availableDeviceExtensions)
         {
             requiredExtensions.erase(extension.extensionName);
@@ -0,0 +1,159 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include "ImageUtils.hpp"
+
+namespace dvk::utils {
+
+    // Largest stored deflate block
+    static constexpr size_t MAX_STORED_BLOCK = 65535;
+
+    static const std::array<uint32_t, 256>& getCrcTable()
+    {
+        static const std::array<uint32_t, 256> table = [] {
+            std::array<uint32_t, 256> entries{};
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; bit++)
+                {
+                    crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+                }
+                entries[i] = crc;
+            }
+            return entries;
+        }();
+        return table;
+    }
+
+    static void appendBigEndian(std::vector<uint8_t>& out, uint32_t value)
+    {
+        out.push_back(static_cast<uint8_t>(value >> 24));
+        out.push_back(static_cast<uint8_t>(value >> 16));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static void writeChunk(std::ofstream& file, const char* type, const std::vector<uint8_t>& data)
+    {
+        std::vector<uint8_t> chunk;
+        chunk.reserve(data.size() + 12);
+        appendBigEndian(chunk, static_cast<uint32_t>(data.size()));
+        chunk.insert(chunk.end(), type, type + 4);
+        chunk.insert(chunk.end(), data.begin(), data.end());
+
+        // Over the type and the data, not the length
+        const auto& table = getCrcTable();
+        uint32_t crc = 0xFFFFFFFFu;
+        for (size_t i = 4; i < chunk.size(); i++)
+        {
+            crc = table[(crc ^ chunk[i]) & 0xFF] ^ (crc >> 8);
+        }
+        appendBigEndian(chunk, crc ^ 0xFFFFFFFFu);
+
+        file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+    }
+
+    void writePng(const std::string& fileName, const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t rowPitch, bool bgra)
+    {
+        // Every row starts with its filter type, none
+        size_t rowSize = static_cast<size_t>(width) * 4;
+        std::vector<uint8_t> scanlines;
+        scanlines.reserve((rowSize + 1) * height);
+        for (uint32_t y = 0; y < height; y++)
+        {
+            const uint8_t* row = pixels + static_cast<size_t>(y) * rowPitch;
+            scanlines.push_back(0);
+            for (uint32_t x = 0; x < width; x++)
+            {
+                const uint8_t* pixel = row + static_cast<size_t>(x) * 4;
+                scanlines.push_back(bgra ? pixel[2] : pixel[0]);
+                scanlines.push_back(pixel[1]);
+                scanlines.push_back(bgra ? pixel[0] : pixel[2]);
+                scanlines.push_back(pixel[3]);
+            }
+        }
+
+        // zlib stream of stored blocks, followed by the Adler-32 of the scanlines
+        std::vector<uint8_t> compressed;
+        compressed.reserve(scanlines.size() + scanlines.size() / MAX_STORED_BLOCK * 5 + 16);
+        compressed.push_back(0x78);
+        compressed.push_back(0x01);
+        size_t offset = 0;
+        do
+        {
+            size_t length = std::min(MAX_STORED_BLOCK, scanlines.size() - offset);
+            bool last = offset + length == scanlines.size();
+            compressed.push_back(last ? 1 : 0);
+            compressed.push_back(static_cast<uint8_t>(length));
+            compressed.push_back(static_cast<uint8_t>(length >> 8));
+            compressed.push_back(static_cast<uint8_t>(~length));
+            compressed.push_back(static_cast<uint8_t>(~length >> 8));
+            compressed.insert(compressed.end(), scanlines.begin() + static_cast<std::ptrdiff_t>(offset), scanlines.begin() + static_cast<std::ptrdiff_t>(offset + length));
+            offset += length;
+        } while (offset < scanlines.size());
+
+        uint32_t a = 1, b = 0;
+        for (uint8_t byte : scanlines)
+        {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        appendBigEndian(compressed, (b << 16) | a);
+
+        std::ofstream file(fileName, std::ios::binary);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to open image file: " + fileName);
+        }
+
+        const uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+        // 8 bits per channel, RGBA, no interlacing
+        std::vector<uint8_t> header;
+        appendBigEndian(header, width);
+        appendBigEndian(header, height);
+        header.insert(header.end(), {8, 6, 0, 0, 0});
+        writeChunk(file, "IHDR", header);
+        writeChunk(file, "IDAT", compressed);
+        writeChunk(file, "IEND", {});
+    }
+
+    void writeRaw(const std::string& fileName, const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t rowPitch, uint32_t bytesPerPixel)
+    {
+        std::ofstream file(fileName, std::ios::binary);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to open image file: " + fileName);
+        }
+
+        auto rowSize = static_cast<std::streamsize>(width) * bytesPerPixel;
+        for (uint32_t y = 0; y < height; y++)
+        {
+            file.write(reinterpret_cast<const char*>(pixels + static_cast<size_t>(y) * rowPitch), rowSize);
+        }
+    }
+
+    uint64_t hashPixels(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t rowPitch, uint32_t bytesPerPixel)
+    {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        size_t rowSize = static_cast<size_t>(width) * bytesPerPixel;
+        for (uint32_t y = 0; y < height; y++)
+        {
+            const uint8_t* row = pixels + static_cast<size_t>(y) * rowPitch;
+            for (size_t i = 0; i < rowSize; i++)
+            {
+                hash = (hash ^ row[i]) * 0x100000001B3ull;
+            }
+        }
+        return hash;
+    }
+
+} // dvk
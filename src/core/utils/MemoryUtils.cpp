@@ -0,0 +1,33 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include "MemoryUtils.hpp"
+
+namespace dvk::utils {
+
+    uint32_t findMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeFilter, VkMemoryPropertyFlags properties)
+    {
+        uint32_t memoryType;
+        if (!tryFindMemoryType(physicalDevice, typeFilter, properties, memoryType)) {
+            throw std::runtime_error("failed to find suitable memory type!");
+        }
+        return memoryType;
+    }
+
+    bool tryFindMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeFilter, VkMemoryPropertyFlags properties, uint32_t& memoryType)
+    {
+        VkPhysicalDeviceMemoryProperties memProperties;
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+        for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+            if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+                memoryType = i;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+} // dvk
@@ -1,12 +1,39 @@
-﻿#include <iostream>
+﻿#include <chrono>
+#include <iostream>
+#include <fstream>
 #include "Engine.hpp"
+#include "HostAllocator.hpp"
+#include "JobBenchmark.hpp"
 
-int main()
+int main(int argc, char** argv)
 {
+    // Baseline of the time to first frame, before anything is set up
+    auto processStart = std::chrono::steady_clock::now();
     try {
-        dvk::Engine engine;
-        engine.run();
+        dvk::Options options = dvk::parseOptions(argc, argv);
+        if (options.jobBenchmark) {
+            if (options.reportOutput.empty()) {
+                dvk::jobs::runJobBenchmark(options.jobThreads, dvk::jobs::DEFAULT_BENCHMARK_JOBS, std::cout);
+            } else {
+                std::ofstream report(options.reportOutput);
+                dvk::jobs::runJobBenchmark(options.jobThreads, dvk::jobs::DEFAULT_BENCHMARK_JOBS, report);
+            }
+            return 0;
+        }
+        if (options.systemAllocator) {
+            dvk::memory::setAllocationCallbacks(nullptr);
+        }
+
+        {
+            dvk::Engine engine(options, processStart);
+            engine.run();
+        }
+
+        if (options.hostMemoryReport) {
+            dvk::memory::getHostAllocator().writeReport(std::cerr);
+        }
     } catch (std::exception& e) {
         std::cerr << e.what() << std::endl;
+        return 1;
     }
 }
\ No newline at end of file
@@ -10,7 +10,7 @@ namespace dvk {
 
     }
 
-    Engine::Engine()
+    Engine::Engine(const Options& options, std::chrono::steady_clock::time_point processStart) : core(options, processStart)
     {
         init();
     }
@@ -0,0 +1,303 @@
+//
+// Created by Arouay on 19/10/2026.
+//
+
+#include <string>
+#include <stdexcept>
+#include "Options.hpp"
+#include "Trace.hpp"
+#include "AllocationCounter.hpp"
+#include "DebugMessageSink.hpp"
+#include "FrameCapture.hpp"
+
+namespace dvk {
+
+    static uint32_t parseUnsigned(const std::string& option, const char* value)
+    {
+        if (value == nullptr)
+        {
+            throw std::runtime_error("Missing value for option " + option);
+        }
+
+        try {
+            return static_cast<uint32_t>(std::stoul(value));
+        } catch (std::exception&) {
+            throw std::runtime_error("Invalid value for option " + option + ": " + value);
+        }
+    }
+
+    static double parseDouble(const std::string& option, const char* value)
+    {
+        if (value == nullptr)
+        {
+            throw std::runtime_error("Missing value for option " + option);
+        }
+
+        try {
+            return std::stod(value);
+        } catch (std::exception&) {
+            throw std::runtime_error("Invalid value for option " + option + ": " + value);
+        }
+    }
+
+    static std::string parseString(const std::string& option, const char* value)
+    {
+        if (value == nullptr)
+        {
+            throw std::runtime_error("Missing value for option " + option);
+        }
+        return value;
+    }
+
+    Options parseOptions(int argc, char** argv)
+    {
+        Options options{};
+
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg(argv[i]);
+            const char* next = i + 1 < argc ? argv[i + 1] : nullptr;
+
+            if (arg == "--headless")
+            {
+                options.headless = true;
+            }
+            else if (arg == "--frames")
+            {
+                options.frames = parseUnsigned(arg, next);
+                i++;
+            }
+            else if (arg == "--width")
+            {
+                options.width = parseUnsigned(arg, next);
+                i++;
+            }
+            else if (arg == "--height")
+            {
+                options.height = parseUnsigned(arg, next);
+                i++;
+            }
+            else if (arg == "--benchmark")
+            {
+                options.benchmark = true;
+            }
+            else if (arg == "--instances")
+            {
+                options.instances = parseUnsigned(arg, next);
+                i++;
+            }
+            else if (arg == "--gpu-driven")
+            {
+                options.gpuDriven = true;
+            }
+            else if (arg == "--async-compute")
+            {
+                options.asyncCompute = true;
+            }
+            else if (arg == "--on-demand")
+            {
+                options.onDemand = true;
+            }
+            else if (arg == "--max-idle-ms")
+            {
+                options.maxIdleMs = parseUnsigned(arg, next);
+                i++;
+            }
+            else if (arg == "--target-fps")
+            {
+                options.targetFps = parseUnsigned(arg, next);
+                i++;
+            }
+            else if (arg == "--resolution-budget")
+            {
+                options.resolutionBudget = parseDouble(arg, next);
+                i++;
+            }
+            else if (arg == "--min-resolution-scale")
+            {
+                options.minResolutionScale = parseDouble(arg, next);
+                i++;
+            }
+            else if (arg == "--warmup")
+            {
+                options.warmupFrames = parseUnsigned(arg, next);
+                i++;
+            }
+            else if (arg == "--report-format")
+            {
+                options.reportFormat = parseString(arg, next);
+                i++;
+            }
+            else if (arg == "--report-output")
+            {
+                options.reportOutput = parseString(arg, next);
+                i++;
+            }
+            else if (arg == "--metrics-output")
+            {
+                options.metricsOutput = parseString(arg, next);
+                i++;
+            }
+            else if (arg == "--system-allocator")
+            {
+                options.systemAllocator = true;
+            }
+            else if (arg == "--host-memory-report")
+            {
+                options.hostMemoryReport = true;
+            }
+            else if (arg == "--check-frame-allocations")
+            {
+                options.checkFrameAllocations = true;
+            }
+            else if (arg == "--job-threads")
+            {
+                options.jobThreads = parseUnsigned(arg, next);
+                i++;
+            }
+            else if (arg == "--job-benchmark")
+            {
+                options.jobBenchmark = true;
+            }
+            else if (arg == "--serial-startup")
+            {
+                options.serialStartup = true;
+            }
+            else if (arg == "--startup-benchmark")
+            {
+                options.startupBenchmark = true;
+            }
+            else if (arg == "--debug-severity")
+            {
+                options.debugSeverity = parseString(arg, next);
+                i++;
+            }
+            else if (arg == "--debug-rate-limit")
+            {
+                options.debugRateLimit = parseUnsigned(arg, next);
+                i++;
+            }
+            else if (arg == "--count-api-calls")
+            {
+                options.countApiCalls = true;
+            }
+            else if (arg == "--capture-dir")
+            {
+                options.captureDir = parseString(arg, next);
+                i++;
+            }
+            else if (arg == "--capture-every")
+            {
+                options.captureEvery = parseUnsigned(arg, next);
+                i++;
+            }
+            else if (arg == "--capture-format")
+            {
+                options.captureFormat = parseString(arg, next);
+                i++;
+            }
+            else if (arg == "--trace-output")
+            {
+                options.traceOutput = parseString(arg, next);
+                i++;
+            }
+            else
+            {
+                throw std::runtime_error("Unknown option: " + arg);
+            }
+        }
+
+        if (options.width == 0 || options.height == 0)
+        {
+            throw std::runtime_error("Render extent must not be empty!");
+        }
+
+        if (options.gpuDriven && options.instances == 0)
+        {
+            throw std::runtime_error("--gpu-driven draws the --instances objects, it needs --instances N");
+        }
+
+        if (options.asyncCompute && !options.gpuDriven)
+        {
+            throw std::runtime_error("--async-compute culls the GPU scene, it needs --gpu-driven");
+        }
+
+        if (options.onDemand && (options.headless || options.benchmark))
+        {
+            throw std::runtime_error("--on-demand only draws when the window needs it, it cannot be combined with --headless or --benchmark");
+        }
+
+        if (options.onDemand && options.maxIdleMs == 0)
+        {
+            throw std::runtime_error("--max-idle-ms must be at least 1");
+        }
+
+        if (options.resolutionBudget < 0.0)
+        {
+            throw std::runtime_error("--resolution-budget must not be negative");
+        }
+
+        if (options.minResolutionScale <= 0.0 || options.minResolutionScale > 1.0)
+        {
+            throw std::runtime_error("--min-resolution-scale must be in (0, 1]");
+        }
+
+        if (options.startupBenchmark && (options.benchmark || options.checkFrameAllocations || options.onDemand))
+        {
+            throw std::runtime_error("--startup-benchmark exits after the first frame, it cannot be combined with --benchmark, --check-frame-allocations or --on-demand");
+        }
+
+        if (options.countApiCalls && !options.benchmark)
+        {
+            throw std::runtime_error("--count-api-calls reports through the benchmark, it needs --benchmark");
+        }
+
+        // Throw on an unknown name
+        DebugMessageSink::parseSeverity(options.debugSeverity);
+        FrameCapture::parseCaptureFormat(options.captureFormat);
+
+        if (options.captureEvery > 0 && options.captureDir.empty())
+        {
+            throw std::runtime_error("--capture-every writes to the capture directory, it needs --capture-dir");
+        }
+
+        if (!options.captureDir.empty() && options.checkFrameAllocations)
+        {
+            throw std::runtime_error("--capture-dir allocates on the frames it captures, it cannot be combined with --check-frame-allocations");
+        }
+
+        if (options.systemAllocator && options.hostMemoryReport)
+        {
+            throw std::runtime_error("--host-memory-report needs the tracking allocator, it cannot be combined with --system-allocator");
+        }
+
+        if (options.checkFrameAllocations)
+        {
+            if (!memory::isAllocationCountingEnabled())
+            {
+                throw std::runtime_error("Allocation counting is not compiled in, configure with -DDVK_ALLOCATION_HOOK=ON to use --check-frame-allocations");
+            }
+            if (!options.headless)
+            {
+                throw std::runtime_error("--check-frame-allocations only runs headless");
+            }
+            if (!options.metricsOutput.empty())
+            {
+                throw std::runtime_error("--check-frame-allocations cannot be combined with --metrics-output, the periodic export allocates");
+            }
+        }
+
+        if (!options.traceOutput.empty() && !trace::isEnabled())
+        {
+            throw std::runtime_error("Tracing is not compiled in, configure with -DDVK_TRACING=ON to use --trace-output");
+        }
+
+        if ((options.headless || options.benchmark) && options.frames == 0)
+        {
+            options.frames = 1000;
+        }
+
+        return options;
+    }
+
+} // dvk